@@ -8,14 +8,9 @@
 #include "../externals/imgui/backends/imgui_impl_sdl2.h"
 #include "../externals/imgui/backends/imgui_impl_sdlrenderer2.h"
 #include "../externals/imgui/imgui.h"
-#include "core/CollisionSystem.h"
 #include "core/Components.h"
 #include "core/Constants.h"
-#include "core/DungeonGenerator.hpp"
-#include "core/EntityFactory.hpp"
 #include "core/GraphicsContext.hpp"
-#include "core/WanderSystem.hpp"
-#include "core/walkerdungeon.hpp"
 #include "events/GameEvent.h"
 #include "rendering/Renderer.hpp"
 
@@ -24,33 +19,32 @@ using namespace Constants::Sprites; // This lets us use IDs:: and Tilesets::
                                     // directly
 
 CollisionTest::CollisionTest()
-    : m_registry(),
+    : m_simulation(),
       m_graphicsContext(std::make_unique<Core::GraphicsContext>(
           "Collision Test", Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT,
           SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE)),
       m_gameManager(),
-      m_entityFactory(std::make_unique<Core::EntityFactory>(m_registry)),
-      m_dungeonGenerator(nullptr),
       m_viewport{0, 0, VIEWPORT_WIDTH, VIEWPORT_HEIGHT},
       m_currentWindowWidth(Constants::WINDOW_WIDTH),
       m_currentWindowHeight(Constants::WINDOW_HEIGHT),
       m_performanceWindow(std::make_unique<UI::PerformanceWindow>(
           "Performance", &m_showPerformanceWindow)),
+      m_schedulerMetricsWindow(std::make_unique<UI::SchedulerMetricsWindow>(
+          "Scheduler Metrics", &m_showSchedulerMetrics)),
       m_entityInspector(
           std::make_unique<UI::EntityInspectorWindow>(&m_showEntityInspector)),
       m_tmxLoader(std::make_unique<UI::TmxLoaderWindow>(&m_gameManager,
                                                         &m_showTmxLoader)),
       m_walkerDungeon(
           std::make_unique<UI::WalkerDungeonWindow>(&m_showWalkerDungeon)),
+      m_influenceMap(std::make_unique<UI::InfluenceMapWindow>(
+          "Influence Map", &m_showInfluenceMap)),
       m_renderer(std::make_unique<Rendering::Renderer>(&m_gameManager)),
-      m_inputHandler(
-          std::make_unique<Input::InputHandler>(&m_gameManager, m_eventBus)),
-      m_eventBus(), m_running(true), m_lastFrameTime(0), m_lastTickTime(0),
-      m_accumulator(0), m_currentTick(0), m_showPerformanceWindow(true),
+      m_inputHandler(std::make_unique<Input::InputHandler>(&m_gameManager)),
+      m_running(true),
+      m_showPerformanceWindow(true), m_showSchedulerMetrics(true),
       m_showEntityInspector(true), m_showTmxLoader(true),
-      m_showWalkerDungeon(true), m_usingDungeonGenerator(false),
-      m_totalFloorCount(100), m_minHall(3), m_maxHall(10), m_roomDim(5),
-      m_tileWidth(8), m_tileHeight(8) {
+      m_showWalkerDungeon(true), m_showInfluenceMap(true) {
   std::cout << "Starting CollisionTest constructor..." << std::endl;
 
   // Initialize SDL
@@ -94,12 +88,8 @@ CollisionTest::CollisionTest()
   }
   std::cout << "Tilesets loaded successfully" << std::endl;
 
-  // Initialize dungeon generator with default tile size
-  std::cout << "Initializing dungeon generator..." << std::endl;
-  m_dungeonGenerator = std::make_unique<Core::WalkerDungeonGenerator>(
-      m_totalFloorCount, m_minHall, m_maxHall, m_roomDim, m_tileWidth,
-      m_tileHeight);
-  std::cout << "Dungeon generator initialized successfully" << std::endl;
+  // TMX scenarios are loaded through the game's map loader
+  m_simulation.setMapLoader(m_gameManager.getMapLoader());
 
   // Setup ImGui
   std::cout << "Setting up ImGui..." << std::endl;
@@ -114,6 +104,14 @@ CollisionTest::CollisionTest()
   ImGui_ImplSDLRenderer2_Init(m_graphicsContext->getRenderer());
   std::cout << "ImGui setup completed" << std::endl;
 
+  // Hook scheduler instrumentation into the metrics panel
+  m_simulation.getScheduler().setMetrics(&m_schedulerMetrics);
+  m_simulation.getTimedEvents().setMetrics(&m_timedEventMetrics);
+  m_schedulerMetricsWindow->addSource(&m_schedulerMetrics);
+  m_schedulerMetricsWindow->addSource(&m_timedEventMetrics);
+  m_performanceWindow->setSystemScheduler(&m_simulation.getSystems());
+  m_influenceMap->setInfluenceMap(&m_simulation.getInfluenceMap());
+
   // Setup event handlers
   std::cout << "Setting up event handlers..." << std::endl;
   setupEventHandlers();
@@ -124,48 +122,29 @@ CollisionTest::CollisionTest()
   setupTestScenario();
   std::cout << "Test scenario setup completed" << std::endl;
 
-  // Initialize viewport position
-  updateViewportPosition();
-
   // Set up walker dungeon callback
   m_walkerDungeon->setGenerationCallback([this]() {
     // Update dungeon generator parameters from GUI
-    m_totalFloorCount = m_walkerDungeon->getTotalFloorCount();
-    m_minHall = m_walkerDungeon->getMinHall();
-    m_maxHall = m_walkerDungeon->getMaxHall();
-    m_roomDim = m_walkerDungeon->getRoomDim();
-    m_tileWidth = m_walkerDungeon->getTileWidth();
-    m_tileHeight = m_walkerDungeon->getTileHeight();
-
-    // Update dungeon generator
-    m_dungeonGenerator->setParameters(m_totalFloorCount, m_minHall, m_maxHall,
-                                      m_roomDim, m_tileWidth, m_tileHeight);
+    auto &scenario = m_simulation.getScenario();
+    scenario.usingDungeonGenerator = 1;
+    scenario.totalFloorCount = m_walkerDungeon->getTotalFloorCount();
+    scenario.minHall = m_walkerDungeon->getMinHall();
+    scenario.maxHall = m_walkerDungeon->getMaxHall();
+    scenario.roomDim = m_walkerDungeon->getRoomDim();
+    scenario.tileWidth = m_walkerDungeon->getTileWidth();
+    scenario.tileHeight = m_walkerDungeon->getTileHeight();
 
     // Generate new dungeon
-    m_usingDungeonGenerator = true;
     setupTestScenario();
   });
 
   // Set up TMX loader callback
   m_tmxLoader->setRegenerationCallback([this]() {
-    m_usingDungeonGenerator = false;
-    if (loadTmxMap()) {
-      setupTestScenario();
-    }
+    m_simulation.getScenario().usingDungeonGenerator = 0;
+    setupTestScenario();
   });
 }
 
-bool CollisionTest::loadTmxMap() {
-  std::cout << "Loading TMX file..." << std::endl;
-  if (!m_gameManager.getMapLoader()->loadMap(Constants::Assets::MAP_TMX,
-                                             m_registry)) {
-    std::cerr << "Failed to load TMX file!" << std::endl;
-    return false;
-  }
-  std::cout << "TMX file loaded successfully" << std::endl;
-  return true;
-}
-
 bool CollisionTest::loadTilesets() {
   std::cout << "Loading sprite sheet from: " << Constants::Assets::SPRITE_SHEET
             << std::endl;
@@ -202,6 +181,8 @@ bool CollisionTest::loadTilesets() {
 }
 
 CollisionTest::~CollisionTest() {
+  stopSimulationThread();
+
   // Cleanup ImGui
   ImGui_ImplSDLRenderer2_Shutdown();
   ImGui_ImplSDL2_Shutdown();
@@ -213,206 +194,26 @@ CollisionTest::~CollisionTest() {
 
 void CollisionTest::setupEventHandlers() {
   // Log player movement events
-  m_eventBus.subscribe(GameEventType::PLAYER_MOVED, [](const GameEvent &event) {
-    const auto &moveEvent = static_cast<const PlayerMovedEvent &>(event);
-    std::cout << "Player moved to: (" << moveEvent.newX << ", "
-              << moveEvent.newY << ")\n";
-  });
+  m_simulation.getEventBus()
+      .subscribe<PlayerMovedEvent, [](const PlayerMovedEvent &event) {
+        std::cout << "Player moved to: (" << event.newX << ", " << event.newY
+                  << ")\n";
+      }>();
 }
 
-void CollisionTest::setupTestScenario() {
-  std::cout << "Starting setupTestScenario..." << std::endl;
-
-  // Clear existing entities
-  m_registry.clear();
-
-  // If we're using the dungeon generator, generate a new dungeon
-  if (m_usingDungeonGenerator && m_dungeonGenerator) {
-    std::cout << "Generating dungeon..." << std::endl;
-    m_dungeonGenerator->generate();
-    std::cout << "Dungeon generated" << std::endl;
-
-    const auto &floors = m_dungeonGenerator->getFloors();
-    const auto &walls = m_dungeonGenerator->getWalls();
-
-    if (floors.empty()) {
-      std::cerr << "No floor tiles generated!" << std::endl;
-      return;
-    }
-
-    // Create floor tiles
-    std::cout << "Creating floor tiles..." << std::endl;
-    for (const auto &floor : floors) {
-      m_entityFactory->createFloor(floor.x, floor.y,
-                                   Constants::Sprites::Tilesets::MAIN_TILESET);
-    }
-    std::cout << "Floor tiles created" << std::endl;
-
-    // Create wall tiles with collision components
-    std::cout << "Creating wall tiles..." << std::endl;
-    for (const auto &wall : walls) {
-      m_entityFactory->createWall(wall.x, wall.y,
-                                  Constants::Sprites::Tilesets::MAIN_TILESET);
-    }
-    std::cout << "Wall tiles created" << std::endl;
-
-    // Create player and mobs
-    if (!floors.empty()) {
-      m_entityFactory->createPlayer(floors[0].x, floors[0].y,
-                                    Constants::Sprites::Tilesets::MAIN_TILESET);
-
-      // Create 5 mobs at different positions, ensuring they have space to move
-      int mobsCreated = 0;
-      int attempts = 0;
-      const int maxAttempts = floors.size();
-
-      while (mobsCreated < 30 && attempts < maxAttempts) {
-        // Pick a random floor tile
-        int randomIndex = 1 + (rand() % (floors.size() - 1));
-        const auto &floor = floors[randomIndex];
-
-        // Count nearby floor tiles to ensure there's room to move
-        int openSpaces = 0;
-        for (const auto &checkFloor : floors) {
-          int dx = abs(checkFloor.x - floor.x);
-          int dy = abs(checkFloor.y - floor.y);
-          if (dx <= 2 && dy <= 2) { // Check in a 5x5 area
-            openSpaces++;
-          }
-        }
-
-        // Only spawn if there are enough open spaces
-        if (openSpaces >= 8) {
-          // Create mob entity
-          auto mobEntity = m_registry.create();
-
-          // Add position component
-          m_registry.emplace<Components::PositionComponent>(mobEntity, floor.x,
-                                                            floor.y);
-
-          // Add collision component
-          m_registry.emplace<Components::CollisionComponent>(mobEntity, true);
-
-          // Add sprite component
-          m_registry.emplace<Components::SpriteComponent>(
-              mobEntity, Constants::Sprites::Tilesets::MAIN_TILESET, IDs::MOB);
-
-          // Add mob tag
-          m_registry.emplace<Components::MobTag>(mobEntity);
-
-          // Add name component
-          m_registry.emplace<Components::Name>(
-              mobEntity, "Enemy Mob " + std::to_string(mobsCreated + 1));
-
-          // Add and initialize wander component with faster movement
-          auto &wander =
-              m_registry.emplace<Components::WanderComponent>(mobEntity);
-          wander.moveCooldown = 300;
-          wander.lastMoveTime = SDL_GetTicks();
-          wander.direction = -1;
-
-          mobsCreated++;
-          std::cout << "Created mob " << mobsCreated << " at (" << floor.x
-                    << ", " << floor.y << ") with " << openSpaces
-                    << " open spaces nearby" << std::endl;
-        }
-        attempts++;
-      }
-
-      if (mobsCreated < 5) {
-        std::cout << "Warning: Only able to create " << mobsCreated
-                  << " mobs with sufficient space" << std::endl;
-      }
-    }
-  } else {
-    // For TMX maps, reload the map to ensure entities are properly created
-    std::cout << "Reloading TMX map..." << std::endl;
-    if (!m_gameManager.getMapLoader()->loadMap(Constants::Assets::MAP_TMX,
-                                               m_registry)) {
-      std::cerr << "Failed to reload TMX map!" << std::endl;
-      return;
-    }
-    std::cout << "TMX map reloaded successfully" << std::endl;
-
-    // For TMX maps, find suitable positions for the player and mobs
-    auto floorView =
-        m_registry.view<Components::PositionComponent, Components::FloorTag>();
-
-    // Debug: Print all floor tiles in the registry
-    std::cout << "Searching for floor tiles in registry..." << std::endl;
-
-    size_t floorCount = 0;
-    for (auto entity : floorView) {
-      const auto &pos = floorView.get<Components::PositionComponent>(entity);
-      std::cout << "Found floor tile at (" << pos.x << ", " << pos.y << ")"
-                << std::endl;
-      floorCount++;
-    }
-    std::cout << "Total floor tiles found: " << floorCount << std::endl;
-
-    // Find the first floor tile for player
-    auto it = floorView.begin();
-    if (it != floorView.end()) {
-      auto firstFloor = *it;
-      const auto &pos =
-          floorView.get<Components::PositionComponent>(firstFloor);
-      std::cout << "Creating player at (" << pos.x << ", " << pos.y << ")"
-                << std::endl;
-
-      // Create player at the first floor tile position
-      m_entityFactory->createPlayer(pos.x, pos.y,
-                                    Constants::Sprites::Tilesets::MAIN_TILESET);
-
-      // Create 5 mobs at different floor tiles
-      int mobCount = 0;
-      ++it; // Move to next floor tile
-      while (it != floorView.end() && mobCount < 30) {
-        auto floorTile = *it;
-        const auto &mobPos =
-            floorView.get<Components::PositionComponent>(floorTile);
-        std::cout << "Creating mob " << (mobCount + 1) << " at (" << mobPos.x
-                  << ", " << mobPos.y << ")" << std::endl;
-
-        // Create mob entity
-        auto mobEntity = m_registry.create();
-
-        // Add position component
-        m_registry.emplace<Components::PositionComponent>(mobEntity, mobPos.x,
-                                                          mobPos.y);
-
-        // Add collision component
-        m_registry.emplace<Components::CollisionComponent>(mobEntity, true);
-
-        // Add sprite component
-        m_registry.emplace<Components::SpriteComponent>(
-            mobEntity, Constants::Sprites::Tilesets::MAIN_TILESET, IDs::MOB);
-
-        // Add mob tag
-        m_registry.emplace<Components::MobTag>(mobEntity);
-
-        // Add name component
-        m_registry.emplace<Components::Name>(
-            mobEntity, "Enemy Mob " + std::to_string(mobCount + 1));
-
-        // Add and initialize wander component
-        auto &wander =
-            m_registry.emplace<Components::WanderComponent>(mobEntity);
-        wander.moveCooldown = 500;
-        wander.lastMoveTime = SDL_GetTicks();
-        wander.direction = -1;
-
-        ++it;
-        ++mobCount;
-      }
-    } else {
-      std::cerr << "No floor tiles found in TMX map!" << std::endl;
-      return;
-    }
+bool CollisionTest::startRecording(const std::string &path) {
+  if (!m_simulation.startRecording(path)) {
+    return false;
   }
+  updateViewportPosition();
+  return true;
+}
+
+void CollisionTest::setupTestScenario() {
+  m_simulation.resetScenario();
 
   // Update viewport and camera position
   updateViewportPosition();
-  std::cout << "setupTestScenario completed" << std::endl;
 }
 
 void CollisionTest::updateViewportPosition() {
@@ -447,24 +248,98 @@ void CollisionTest::handleInput() {
       }
     }
 
+    // Tab toggles fast-forward unless an ImGui field has keyboard focus
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_TAB &&
+        !ImGui::GetIO().WantTextInput) {
+      setFastForward(!m_fastForward.load(std::memory_order_relaxed));
+      continue;
+    }
+
     // Let the input handler process game-specific events
-    m_inputHandler->handleInput(event, m_registry, nullptr);
+    std::lock_guard<std::mutex> lock(m_worldMutex);
+    m_inputHandler->handleInput(event, m_simulation.getRegistry(), nullptr);
+  }
+
+  // Hand this frame's commands to the simulation side
+  std::lock_guard<std::mutex> lock(m_inboxMutex);
+  const auto &pending = m_inputHandler->getPendingCommands();
+  m_commandInbox.insert(m_commandInbox.end(), pending.begin(), pending.end());
+  m_inputHandler->clearPendingCommands();
+}
+
+void CollisionTest::stepSimulation() {
+  // Mode changes requested from the UI take effect between frames
+  bool fastForward = m_fastForward.load(std::memory_order_relaxed);
+  if (fastForward != m_clock.isFastForward()) {
+    m_clock.setMode(fastForward ? Core::SimulationClock::Mode::FastForward
+                                : Core::SimulationClock::Mode::RealTime);
+  }
+
+  // Update game logic at fixed time steps; the clock decides how many
+  m_clock.beginFrame(SDL_GetTicks());
+  bool ticked = false;
+  while (m_clock.nextTick(SDL_GetTicks())) {
+    tickUpdate();
+    ticked = true;
+  }
+  if (ticked) {
+    publishSnapshot();
+  }
+}
+
+void CollisionTest::simulationLoop() {
+  m_clock.start(SDL_GetTicks());
+  while (m_simulationRunning.load(std::memory_order_acquire)) {
+    stepSimulation();
+
+    // Sleep until the next tick is due rather than spin; fast-forward
+    // goes straight on
+    if (Uint32 wait = m_clock.msUntilNextTick()) {
+      SDL_Delay(wait);
+    }
+  }
+}
+
+void CollisionTest::stopSimulationThread() {
+  if (m_simulationThread.joinable()) {
+    m_simulationRunning.store(false, std::memory_order_release);
+    m_simulationThread.join();
   }
 }
 
 void CollisionTest::tickUpdate() {
-  // Update tick count
-  m_currentTick++;
-  m_lastTickTime = SDL_GetTicks();
+  // A live tick applies the input gathered since the previous tick
+  {
+    std::lock_guard<std::mutex> lock(m_inboxMutex);
+    m_tickCommands.swap(m_commandInbox);
+  }
 
-  // Update performance monitoring
-  m_performanceWindow->updateTickRate(m_currentTick, m_lastTickTime);
+  std::lock_guard<std::mutex> lock(m_worldMutex);
+  m_simulation.tick(m_tickCommands);
+  m_tickCommands.clear();
+}
 
-  // Update mob wandering for all mobs using ECS collision system
-  Systems::WanderSystem(m_registry, SDL_GetTicks());
+void CollisionTest::publishSnapshot() {
+  FrameSnapshot &frame = m_snapshots.writeBuffer();
+  {
+    std::lock_guard<std::mutex> lock(m_worldMutex);
+    frame.render.capture(m_simulation.getRegistry(),
+                         m_simulation.getCurrentTick());
+    frame.budget = m_simulation.getLastBudgetReport();
+  }
+  m_snapshots.publish();
 }
 
 void CollisionTest::renderFrame() {
+  // Pick up the newest snapshot; without one, redraw the last
+  if (m_snapshots.acquire()) {
+    const FrameSnapshot &frame = m_snapshots.readBuffer();
+    // Update performance monitoring against the wall clock, so fast-forward
+    // shows the real tick rate
+    m_performanceWindow->updateTickRate(frame.render.tick, SDL_GetTicks());
+    m_schedulerMetricsWindow->setBudgetReport(frame.budget);
+  }
+
   // Clear the entire window first
   SDL_RenderClear(m_graphicsContext->getRenderer());
 
@@ -472,7 +347,7 @@ void CollisionTest::renderFrame() {
   SDL_RenderSetViewport(m_graphicsContext->getRenderer(), &m_viewport);
 
   // Render game content within viewport
-  m_renderer->render(m_registry);
+  m_renderer->render(m_snapshots.readBuffer().render);
 
   // Reset viewport for ImGui (full window)
   SDL_RenderSetViewport(m_graphicsContext->getRenderer(), nullptr);
@@ -482,23 +357,37 @@ void CollisionTest::renderFrame() {
   ImGui_ImplSDL2_NewFrame();
   ImGui::NewFrame();
 
+  // The debug tools inspect and edit the live world, so they run between
+  // ticks. Building their widgets is short; drawing happens unlocked below.
+  std::unique_lock<std::mutex> worldLock(m_worldMutex);
+  entt::registry &registry = m_simulation.getRegistry();
+
   // Set default positions for ImGui windows around the viewport
   ImGui::SetNextWindowPos(
       ImVec2(10, 10), ImGuiCond_FirstUseEver); // Performance window top-left
-  m_performanceWindow->render(m_registry);
+  m_performanceWindow->render(registry);
+
+  ImGui::SetNextWindowPos(ImVec2(320, 10),
+                          ImGuiCond_FirstUseEver); // Next to performance
+  m_schedulerMetricsWindow->render(registry);
 
   ImGui::SetNextWindowPos(ImVec2(m_currentWindowWidth - 300, 10),
                           ImGuiCond_FirstUseEver); // Entity inspector top-right
-  m_entityInspector->render(m_registry);
+  m_entityInspector->render(registry);
 
   ImGui::SetNextWindowPos(ImVec2(10, m_currentWindowHeight - 300),
                           ImGuiCond_FirstUseEver); // TMX loader bottom-left
-  m_tmxLoader->render(m_registry);
+  m_tmxLoader->render(registry);
 
   ImGui::SetNextWindowPos(
       ImVec2(m_currentWindowWidth - 300, m_currentWindowHeight - 300),
       ImGuiCond_FirstUseEver); // Walker dungeon bottom-right
-  m_walkerDungeon->render(m_registry);
+  m_walkerDungeon->render(registry);
+
+  ImGui::SetNextWindowPos(ImVec2(320, m_currentWindowHeight - 300),
+                          ImGuiCond_FirstUseEver); // Next to the TMX loader
+  m_influenceMap->render(registry);
+  worldLock.unlock();
 
   // Render ImGui
   ImGui::Render();
@@ -509,9 +398,23 @@ void CollisionTest::renderFrame() {
   SDL_RenderPresent(m_graphicsContext->getRenderer());
 }
 
+void CollisionTest::setFastForward(bool enabled) {
+  m_fastForward.store(enabled, std::memory_order_relaxed);
+  std::cout << "Simulation clock: " << (enabled ? "fast-forward" : "real time")
+            << std::endl;
+}
+
 void CollisionTest::run() {
-  m_lastFrameTime = SDL_GetTicks();
-  m_lastTickTime = m_lastFrameTime;
+  // Give the renderer something to draw before the first tick
+  publishSnapshot();
+
+  if (m_threaded) {
+    std::cout << "Running the simulation on its own thread" << std::endl;
+    m_simulationRunning.store(true, std::memory_order_release);
+    m_simulationThread = std::thread(&CollisionTest::simulationLoop, this);
+  } else {
+    m_clock.start(SDL_GetTicks());
+  }
 
   // Calculate frame time in milliseconds (60 FPS = 16.67ms per frame)
   const Uint32 targetFrameTime = 1000 / 60;
@@ -519,15 +422,11 @@ void CollisionTest::run() {
   while (m_running) {
     Uint32 frameStart = SDL_GetTicks();
 
-    // Calculate delta time and update accumulator
-    Uint32 currentTime = SDL_GetTicks();
-    Uint32 deltaTime = currentTime - m_lastFrameTime;
-    m_lastFrameTime = currentTime;
-    m_accumulator += deltaTime;
-
     // Check for TMX map modifications if we're not using the dungeon generator
-    if (!m_usingDungeonGenerator) {
-      if (m_gameManager.getMapLoader()->isMapModified()) {
+    {
+      std::lock_guard<std::mutex> lock(m_worldMutex);
+      if (!m_simulation.getScenario().usingDungeonGenerator &&
+          m_gameManager.getMapLoader()->isMapModified()) {
         std::cout << "TMX map file modified, reloading..." << std::endl;
         m_gameManager.getMapLoader()->reloadIfModified();
         setupTestScenario();
@@ -537,21 +436,25 @@ void CollisionTest::run() {
     // Handle input
     handleInput();
 
-    // Update game logic at fixed time steps
-    while (m_accumulator >= MS_PER_TICK) {
-      tickUpdate();
-      m_accumulator -= MS_PER_TICK;
+    // Single-threaded, the frame runs its own ticks
+    if (!m_threaded) {
+      stepSimulation();
     }
 
     // Render frame
     renderFrame();
 
-    // Frame limiting
+    // Frame limiting, except when fast-forwarding on this thread. With a
+    // simulation thread, fast-forward doesn't need the render loop to spin.
     Uint32 frameTime = SDL_GetTicks() - frameStart;
-    if (frameTime < targetFrameTime) {
+    bool unlimited =
+        !m_threaded && m_fastForward.load(std::memory_order_relaxed);
+    if (!unlimited && frameTime < targetFrameTime) {
       SDL_Delay(targetFrameTime - frameTime);
     }
   }
+
+  stopSimulationThread();
 }
 
 void CollisionTest::update() {
@@ -561,109 +464,9 @@ void CollisionTest::update() {
 
 void CollisionTest::regenerateDungeon() {
   std::cout << "Regenerating dungeon..." << std::endl;
-
-  // Clear existing entities
-  m_registry.clear();
-
-  // Generate new dungeon layout using walker algorithm
-  m_dungeonGenerator->generate();
-
-  const auto &floors = m_dungeonGenerator->getFloors();
-  const auto &walls = m_dungeonGenerator->getWalls();
-
-  if (floors.empty()) {
-    std::cerr << "No floor tiles generated!" << std::endl;
-    return;
-  }
-
-  // Create floor tiles
-  std::cout << "Creating floor tiles..." << std::endl;
-  for (const auto &floor : floors) {
-    m_entityFactory->createFloor(floor.x, floor.y,
-                                 Constants::Sprites::Tilesets::MAIN_TILESET);
-  }
-  std::cout << "Floor tiles created" << std::endl;
-
-  // Create wall tiles with collision components
-  std::cout << "Creating wall tiles..." << std::endl;
-  for (const auto &wall : walls) {
-    m_entityFactory->createWall(wall.x, wall.y,
-                                Constants::Sprites::Tilesets::MAIN_TILESET);
-  }
-  std::cout << "Wall tiles created" << std::endl;
-
-  // Create player and mobs
-  if (!floors.empty()) {
-    m_entityFactory->createPlayer(floors[0].x, floors[0].y,
-                                  Constants::Sprites::Tilesets::MAIN_TILESET);
-
-    // Create 5 mobs at different positions, ensuring they have space to move
-    int mobsCreated = 0;
-    int attempts = 0;
-    const int maxAttempts = floors.size();
-
-    while (mobsCreated < 5 && attempts < maxAttempts) {
-      // Pick a random floor tile
-      int randomIndex = 1 + (rand() % (floors.size() - 1));
-      const auto &floor = floors[randomIndex];
-
-      // Count nearby floor tiles to ensure there's room to move
-      int openSpaces = 0;
-      for (const auto &checkFloor : floors) {
-        int dx = abs(checkFloor.x - floor.x);
-        int dy = abs(checkFloor.y - floor.y);
-        if (dx <= 2 && dy <= 2) { // Check in a 5x5 area
-          openSpaces++;
-        }
-      }
-
-      // Only spawn if there are enough open spaces
-      if (openSpaces >= 8) {
-        // Create mob entity
-        auto mobEntity = m_registry.create();
-
-        // Add position component
-        m_registry.emplace<Components::PositionComponent>(mobEntity, floor.x,
-                                                          floor.y);
-
-        // Add collision component
-        m_registry.emplace<Components::CollisionComponent>(mobEntity, true);
-
-        // Add sprite component
-        m_registry.emplace<Components::SpriteComponent>(
-            mobEntity, Constants::Sprites::Tilesets::MAIN_TILESET, IDs::MOB);
-
-        // Add mob tag
-        m_registry.emplace<Components::MobTag>(mobEntity);
-
-        // Add name component
-        m_registry.emplace<Components::Name>(
-            mobEntity, "Enemy Mob " + std::to_string(mobsCreated + 1));
-
-        // Add and initialize wander component with faster movement
-        auto &wander =
-            m_registry.emplace<Components::WanderComponent>(mobEntity);
-        wander.moveCooldown = 300;
-        wander.lastMoveTime = SDL_GetTicks();
-        wander.direction = -1;
-
-        mobsCreated++;
-        std::cout << "Created mob " << mobsCreated << " at (" << floor.x << ", "
-                  << floor.y << ") with " << openSpaces << " open spaces nearby"
-                  << std::endl;
-      }
-      attempts++;
-    }
-
-    if (mobsCreated < 5) {
-      std::cout << "Warning: Only able to create " << mobsCreated
-                << " mobs with sufficient space" << std::endl;
-    }
-  }
-
-  // Update viewport position
-  updateViewportPosition();
+  m_simulation.getScenario().usingDungeonGenerator = 1;
+  setupTestScenario();
   std::cout << "Dungeon regeneration completed" << std::endl;
 }
 
-} // namespace Examples
+} // namespace Examples
\ No newline at end of file
@@ -217,8 +217,98 @@ void SchedulerExample::runEventIntegrationExample() {
   }
 }
 
+// Scripted burn effect written as a coroutine instead of a callback chain
+static ScheduledTask burnSequence(Scheduler &scheduler, entt::registry &registry,
+                                  entt::entity target, int pulses) {
+  std::cout << "Burn starts on entity " << static_cast<int>(target)
+            << std::endl;
+
+  for (int pulse = 1; pulse <= pulses; ++pulse) {
+    co_await scheduler.wait(2);
+
+    if (!registry.valid(target)) {
+      co_return;
+    }
+
+    auto &health = registry.get<Health>(target);
+    health.current -= 5;
+    std::cout << "Burn pulse " << pulse << " deals 5 damage" << std::endl;
+  }
+
+  co_await nextTick;
+  std::cout << "Burn fades from entity " << static_cast<int>(target)
+            << std::endl;
+}
+
+void SchedulerExample::runCoroutineExample() {
+  std::cout << "\n=== Scheduler Coroutine Example ===" << std::endl;
+
+  entt::registry registry;
+  entt::dispatcher dispatcher;
+  Scheduler scheduler;
+
+  auto enemy = registry.create();
+  registry.emplace<Health>(enemy, 50, 50);
+
+  // The task runs up to its first co_await here
+  scheduler.spawn(burnSequence(scheduler, registry, enemy, 3));
+
+  for (int tick = 1; tick <= 8; ++tick) {
+    std::cout << "\n-- Tick " << tick << " --" << std::endl;
+    scheduler.update(tick, registry, dispatcher);
+
+    const auto &health = registry.get<Health>(enemy);
+    std::cout << "Enemy health: " << health.current << "/" << health.max
+              << std::endl;
+  }
+}
+
+void SchedulerExample::runSaveRestoreExample() {
+  std::cout << "\n=== Scheduler Save/Restore Example ===" << std::endl;
+
+  entt::registry registry;
+  entt::dispatcher dispatcher;
+  ActionRegistry actionTypes;
+  SchedulerUtils::registerBuiltinActions(actionTypes);
+
+  auto enemy = registry.create();
+  registry.emplace<Health>(enemy, 50, 50);
+
+  // Poison built from registered actions so it can be saved mid-way
+  Scheduler scheduler;
+  SchedulerUtils::scheduleDamageOverTime(scheduler, actionTypes, enemy, 4, 5,
+                                         2, 2);
+
+  for (int tick = 1; tick <= 4; ++tick) {
+    scheduler.update(tick, registry, dispatcher);
+  }
+
+  std::vector<std::byte> save;
+  if (!scheduler.serialize(save)) {
+    return;
+  }
+  std::cout << "Saved " << scheduler.pendingCount() << " pending actions in "
+            << save.size() << " bytes" << std::endl;
+
+  // A fresh scheduler picks up where the first one left off
+  Scheduler restored;
+  if (!restored.restore(save, actionTypes)) {
+    return;
+  }
+
+  for (int tick = 5; tick <= 10; ++tick) {
+    restored.update(tick, registry, dispatcher);
+  }
+
+  const auto &health = registry.get<Health>(enemy);
+  std::cout << "Enemy health after restore: " << health.current << "/"
+            << health.max << std::endl;
+}
+
 void SchedulerExample::run() {
   runSchedulerExample();
   runTimedEventExample();
   runEventIntegrationExample();
+  runCoroutineExample();
+  runSaveRestoreExample();
 }
\ No newline at end of file
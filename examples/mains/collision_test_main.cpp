@@ -1,13 +1,70 @@
+#include "core/HeadlessRuntime.hpp"
+#include "core/services/JobSystem.hpp"
 #include "examples/CollisionTest.hpp"
+#include <entt/entt.hpp>
 #include <iostream>
+#include <string>
 
 int main(int argc, char *argv[]) {
   try {
+    // --record <journal> captures the session, --replay <journal> runs a
+    // captured session back headlessly. --headless runs the simulation with
+    // no window for --ticks <n> ticks (TMX map with --tmx, logging with
+    // --log) and reports its throughput. --fast-forward starts the window
+    // with ticks unlocked from the 60 Hz clock (Tab toggles it), and
+    // --threaded runs the simulation on its own thread. --workers <n> sets
+    // the job system's worker threads (default: one per core but one).
+    bool headless = false;
+    bool fastForward = false;
+    bool threaded = false;
+    unsigned workers = Core::Services::JobSystem::defaultWorkerCount();
+    Core::HeadlessRuntime::Options options;
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "--headless") {
+        headless = true;
+      } else if (arg == "--fast-forward") {
+        fastForward = true;
+      } else if (arg == "--threaded") {
+        threaded = true;
+      } else if (arg == "--tmx") {
+        options.useTmxMap = true;
+      } else if (arg == "--log") {
+        options.log = true;
+      } else if (arg == "--ticks" && i + 1 < argc) {
+        options.ticks = std::stoi(argv[++i]);
+      } else if (arg == "--record" && i + 1 < argc) {
+        options.recordPath = argv[++i];
+      } else if (arg == "--replay" && i + 1 < argc) {
+        options.replayPath = argv[++i];
+        headless = true;
+      } else if (arg == "--workers" && i + 1 < argc) {
+        workers = static_cast<unsigned>(std::stoi(argv[++i]));
+      }
+    }
+
+    // Shared by everything that runs work in parallel
+    entt::locator<Core::Services::JobSystem>::emplace(workers);
+
+    if (headless) {
+      Core::HeadlessRuntime runtime(options);
+      return runtime.run();
+    }
+
     Examples::CollisionTest test;
+    if (fastForward) {
+      test.setFastForward(true);
+    }
+    test.setThreaded(threaded);
+    if (!options.recordPath.empty() &&
+        !test.startRecording(options.recordPath)) {
+      return 1;
+    }
+
     test.run();
     return 0;
   } catch (const std::exception &e) {
     std::cerr << "Error: " << e.what() << std::endl;
     return 1;
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/Components.h"
+#include <SDL2/SDL.h>
+#include <entt/entity/registry.hpp>
+
+namespace Systems {
+
+// Chebyshev distance in tiles to the nearest player up to which a mob stays
+// in each bucket; further than AI_LOD_FAR_RANGE it goes dormant. Near covers
+// the screen around the player.
+constexpr int AI_LOD_NEAR_RANGE = 16;
+constexpr int AI_LOD_MID_RANGE = 32;
+constexpr int AI_LOD_FAR_RANGE = 64;
+
+// Ticks between AI updates in the mid and far buckets
+constexpr Uint32 AI_LOD_MID_PERIOD = 4;
+constexpr Uint32 AI_LOD_FAR_PERIOD = 16;
+
+// Each tick re-buckets one slice of the mobs, so a bucket is at most this
+// many ticks stale and its cost is spread evenly. Mobs should be created in
+// the near bucket; until their slice comes up they have no other.
+constexpr Uint32 AI_LOD_REBUCKET_PERIOD = 16;
+
+void AiLodSystem(entt::registry &registry, Uint32 currentTick);
+
+// Call function(entity, components...) for the entities with Get whose LOD
+// bucket is due this tick, one bucket at a time; dormant ones never are. AI
+// systems iterate through this instead of a plain view, so their cost
+// follows what is near the player. The mid and far buckets fall due on
+// different ticks, so they don't add up.
+template <typename... Get, typename... Exclude, typename Func>
+void ForEachDueAi(entt::registry &registry, Uint32 currentTick,
+                  entt::exclude_t<Exclude...> exclude, Func &&function) {
+  registry.view<Get..., Components::AiLodNearTag>(exclude).each(function);
+  if (currentTick % AI_LOD_MID_PERIOD == 1) {
+    registry.view<Get..., Components::AiLodMidTag>(exclude).each(function);
+  }
+  if (currentTick % AI_LOD_FAR_PERIOD == 2) {
+    registry.view<Get..., Components::AiLodFarTag>(exclude).each(function);
+  }
+}
+
+} // namespace Systems
@@ -3,12 +3,81 @@
 #include "../events/EventBus.h"
 #include "../events/GameEvent.h"
 #include "Components.h"
+#include "OccupancyGrid.hpp"
+#include "services/JobSystem.hpp"
 #include <SDL2/SDL.h>
+#include <cstdlib>
 #include <entt/entity/registry.hpp>
+#include <entt/locator/locator.hpp>
+#include <span>
 #include <vector>
 
 class CollisionSystem {
 public:
+  // A cell-to-cell segment for the batch queries
+  struct Ray {
+    int fromX;
+    int fromY;
+    int toX;
+    int toY;
+  };
+
+  // Where a ray stopped: the first blocked cell it entered, or its target
+  struct RaycastHit {
+    bool hit = false;
+    int x = 0;
+    int y = 0;
+    entt::entity entity = entt::null; // What blocked it; null off the map
+  };
+
+  // Walk the cells from one cell towards another and stop at the first
+  // blocked one after the start, target included. Cells are visited in the
+  // order the line between their centres crosses them (DDA), so the cost is
+  // one step per cell crossed however many entities exist. A line through a
+  // corner squeezes past unless both cells beside it are blocked.
+  static RaycastHit Raycast(const Core::OccupancyGrid &grid, int fromX,
+                            int fromY, int toX, int toY,
+                            bool includeMoving = true) {
+    return Trace(grid, {fromX, fromY, toX, toY}, includeMoving, true);
+  }
+
+  // Whether nothing blocks the cells between two cells. Neither end counts,
+  // so a mob can see the player standing at the target.
+  static bool HasLineOfSight(const Core::OccupancyGrid &grid, int fromX,
+                             int fromY, int toX, int toY,
+                             bool includeMoving = true) {
+    return !Trace(grid, {fromX, fromY, toX, toY}, includeMoving, false).hit;
+  }
+
+  // Batch variants for many pairs at once, spread over the shared JobSystem.
+  // Results line up with rays.
+  static void RaycastBatch(const Core::OccupancyGrid &grid,
+                           std::span<const Ray> rays,
+                           std::span<RaycastHit> hits,
+                           bool includeMoving = true) {
+    entt::locator<Core::Services::JobSystem>::value_or().parallelFor(
+        rays.size(),
+        [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            hits[i] = Trace(grid, rays[i], includeMoving, true);
+          }
+        },
+        RAY_GRAIN);
+  }
+  static void LineOfSightBatch(const Core::OccupancyGrid &grid,
+                               std::span<const Ray> rays,
+                               std::span<bool> visible,
+                               bool includeMoving = true) {
+    entt::locator<Core::Services::JobSystem>::value_or().parallelFor(
+        rays.size(),
+        [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            visible[i] = !Trace(grid, rays[i], includeMoving, false).hit;
+          }
+        },
+        RAY_GRAIN);
+  }
+
   // Check if a position would result in a collision
   static bool CheckCollision(const entt::registry &registry,
                              const Components::PositionComponent &pos,
@@ -64,10 +133,9 @@ public:
       pos->x = newPos.x;
       pos->y = newPos.y;
 
-      // Emit movement event if it's a player
+      // Queue a movement event if it's a player; delivered on the next flush
       if (registry.all_of<Components::PlayerMarker>(entity)) {
-        PlayerMovedEvent event(pos->x, pos->y);
-        eventBus.publish(event);
+        eventBus.enqueue(PlayerMovedEvent{entity, pos->x, pos->y});
       }
     }
 
@@ -159,4 +227,60 @@ public:
       }
     }
   }
+
+private:
+  // Rays are cheap; hand them to other threads in large chunks
+  static constexpr std::size_t RAY_GRAIN = 256;
+
+  static RaycastHit Trace(const Core::OccupancyGrid &grid, const Ray &ray,
+                          bool includeMoving, bool includeTarget) {
+    RaycastHit result;
+    const int dx = std::abs(ray.toX - ray.fromX);
+    const int dy = std::abs(ray.toY - ray.fromY);
+    const int stepX = ray.toX > ray.fromX ? 1 : -1;
+    const int stepY = ray.toY > ray.fromY ? 1 : -1;
+
+    auto blocked = [&](int x, int y) {
+      return (includeTarget || x != ray.toX || y != ray.toY) &&
+             grid.isBlocked(x, y, includeMoving);
+    };
+    auto stop = [&](int x, int y) {
+      result.hit = true;
+      result.x = x;
+      result.y = y;
+      result.entity = grid.getOccupant(x, y, includeMoving);
+      return result;
+    };
+
+    // After ix steps across and iy down, the line leaves the current cell
+    // through whichever edge it reaches first; comparing the two crossings
+    // scaled by 2 * dx * dy keeps this in integers
+    int x = ray.fromX;
+    int y = ray.fromY;
+    for (int ix = 0, iy = 0; ix < dx || iy < dy;) {
+      const long long crossX = (2LL * ix + 1) * dy;
+      const long long crossY = (2LL * iy + 1) * dx;
+      if (ix < dx && iy < dy && crossX == crossY) {
+        if (blocked(x + stepX, y) && blocked(x, y + stepY)) {
+          return stop(x + stepX, y);
+        }
+        x += stepX;
+        y += stepY;
+        ix++;
+        iy++;
+      } else if (iy >= dy || (ix < dx && crossX < crossY)) {
+        x += stepX;
+        ix++;
+      } else {
+        y += stepY;
+        iy++;
+      }
+      if (blocked(x, y)) {
+        return stop(x, y);
+      }
+    }
+    result.x = ray.toX;
+    result.y = ray.toY;
+    return result;
+  }
 };
\ No newline at end of file
@@ -2,7 +2,10 @@
 
 #include "Constants.h"
 #include <SDL.h>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 // Core game components
 namespace Components {
@@ -94,11 +97,80 @@ struct MobTag {
   // Empty marker component
 };
 
+// Marker component for mobs chasing the player rather than wandering
+struct PursuitTag {
+  // Empty marker component
+};
+
+// AI level of detail: how often a mob's AI runs, by its distance to the
+// player. Systems::AiLodSystem keeps exactly one on every mob with a
+// WanderComponent; as separate storages, each bucket can be iterated alone.
+struct AiLodNearTag {
+  // Every tick
+};
+struct AiLodMidTag {
+  // Every Systems::AI_LOD_MID_PERIOD ticks
+};
+struct AiLodFarTag {
+  // Every Systems::AI_LOD_FAR_PERIOD ticks
+};
+struct AiLodDormantTag {
+  // Never, until the player comes closer
+};
+
 // Component for wandering behavior
 struct WanderComponent {
   int direction = -1; // 0 = up, 1 = right, 2 = down, 3 = left
-  Uint32 lastMoveTime = 0;
-  Uint32 moveCooldown = 1000; // ms between steps
+  Uint32 lastMoveTick = 0;
+  Uint32 moveCooldown = 63; // Ticks between steps (~1 s at 60 Hz)
+  // The mob's own random stream (xorshift32, never zero); seed it with
+  // Systems::WanderSystem::seedFor so mobs don't move in lockstep
+  std::uint32_t rngState = 1;
+};
+
+// Planned route in tile cells, excluding the cell it starts from. Replanning
+// reuses the buffer, so following a moving target doesn't allocate.
+struct PathComponent {
+  struct Step {
+    std::int16_t x;
+    std::int16_t y;
+  };
+
+  std::vector<Step> steps;
+  std::size_t next = 0; // Index of the next step to take
+  int goalX = 0;
+  int goalY = 0;
+
+  // Coarse route of a hierarchical query, ending at the goal. steps then
+  // only cover the leg to the last waypoint reached; the next leg is refined
+  // when they run out. Single-level queries leave these alone.
+  std::vector<Step> waypoints;
+  std::size_t nextWaypoint = 0;
+
+  bool isDone() const { return next >= steps.size(); }
+};
+
+// Cells an entity can see within radius, as a bitset over the square around
+// the cell it was computed from. Recomputing reuses the bits, and only
+// happens when the entity moves or a wall near it changes.
+struct FieldOfViewComponent {
+  int radius = 8;
+  int originX = 0;
+  int originY = 0;
+  int computedRadius = -1; // -1 until first computed
+  std::vector<std::uint64_t> bits{};
+
+  bool canSee(int x, int y) const {
+    const int side = 2 * computedRadius + 1;
+    const int col = x - originX + computedRadius;
+    const int row = y - originY + computedRadius;
+    if (computedRadius < 0 || col < 0 || row < 0 || col >= side ||
+        row >= side) {
+      return false;
+    }
+    const int bit = row * side + col;
+    return (bits[bit / 64] >> (bit % 64)) & 1;
+  }
 };
 
 // Sprite component for rendering entities using tileset sprites or custom
@@ -88,6 +88,9 @@ constexpr int DEFAULT_FLOOR_COUNT = 2000;
 constexpr int DEFAULT_MIN_HALL = 4;
 constexpr int DEFAULT_MAX_HALL = 12;
 constexpr int DEFAULT_ROOM_DIM = 3;
+
+// How far the player sees, in tiles; beyond it the map is fogged
+constexpr int PLAYER_SIGHT = 10;
 } // namespace Game
 
 // Viewport and rendering settings
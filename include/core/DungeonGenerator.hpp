@@ -30,6 +30,9 @@ public:
   void setParameters(int totalFloorCount, int minHall, int maxHall, int roomDim,
                      int tileWidth, int tileHeight) override;
 
+  // Seed for the next generate(), so a recorded dungeon can be rebuilt
+  void setSeed(unsigned int newSeed) { seed = newSeed; }
+
 private:
   int totalFloorCount;
   int minHall;
@@ -37,6 +40,7 @@ private:
   int roomDim;
   int tileWidth;
   int tileHeight;
+  unsigned int seed;
 
   std::vector<SDL_Point> floors;
   std::vector<SDL_Point> walls;
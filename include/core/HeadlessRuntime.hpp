@@ -0,0 +1,37 @@
+#pragma once
+
+#include "core/Simulation.hpp"
+#include "core/TmxMapLoader.h"
+#include <string>
+
+namespace Core {
+
+// Runs the simulation without initializing any SDL subsystem: no window,
+// renderer, fonts or audio. Ticks run back to back with no pacing, so the
+// reported rate is the cost of the tick pipeline alone.
+class HeadlessRuntime {
+public:
+  struct Options {
+    int ticks = 3600;       // Ticks to run when not replaying
+    std::string recordPath; // Journal to record to, if any
+    std::string replayPath; // Journal to replay instead of running live
+    bool useTmxMap = false; // Load the TMX map instead of generating a dungeon
+    bool log = false;       // Keep the per-event console logging
+  };
+
+  explicit HeadlessRuntime(const Options &options);
+
+  // Returns the process exit code: non-zero on setup failure or when a
+  // replay diverges from its recording
+  int run();
+
+private:
+  int runLive();
+  int runReplay();
+
+  Options options;
+  TmxMapLoader mapLoader{nullptr};
+  Simulation simulation;
+};
+
+} // namespace Core
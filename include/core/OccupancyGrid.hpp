@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace Core {
+
+// Which entity blocks each cell of the map, for queries that walk cells
+// instead of scanning every collider. Static colliders (TileColliderTag) are
+// laid down by build(); colliders that move are stamped over them by
+// refresh(), which only touches the cells it stamped last time. A cell
+// counts as occupied by the same rule as CollisionSystem::CheckCollision:
+// a blocking collider, or the player. Cells outside the map are solid.
+class OccupancyGrid {
+public:
+  void build(const entt::registry &registry);
+  void refresh(const entt::registry &registry);
+  void clear();
+  // Follow a collider that moved during the tick, so later queries see it
+  // before the next refresh()
+  void moveOccupant(entt::entity entity, int fromX, int fromY, int toX,
+                    int toY);
+
+  bool contains(int x, int y) const {
+    return x >= originX && y >= originY && x < originX + width &&
+           y < originY + height;
+  }
+  // Whether the cell stops movement and rays, counting moving colliders or
+  // only the static ones
+  bool isBlocked(int x, int y, bool includeMoving = true) const {
+    if (!contains(x, y)) {
+      return true;
+    }
+    const int index = toIndex(x, y);
+    return walls[index] != entt::null ||
+           (includeMoving && moving[index] != entt::null);
+  }
+  // The entity occupying a cell, walls first; null when empty or outside
+  entt::entity getOccupant(int x, int y, bool includeMoving = true) const {
+    if (!contains(x, y)) {
+      return entt::null;
+    }
+    const int index = toIndex(x, y);
+    return walls[index] != entt::null || !includeMoving ? walls[index]
+                                                        : moving[index];
+  }
+
+  int getOriginX() const { return originX; }
+  int getOriginY() const { return originY; }
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+private:
+  int toIndex(int x, int y) const {
+    return (y - originY) * width + x - originX;
+  }
+
+  int originX = 0;
+  int originY = 0;
+  int width = 0;
+  int height = 0;
+  std::vector<entt::entity> walls;
+  std::vector<entt::entity> moving;
+  std::vector<int> stamped; // Cells refresh() wrote to moving
+};
+
+} // namespace Core
@@ -18,6 +18,12 @@ public:
   // Run the Event Integration example
   void runEventIntegrationExample();
 
+  // Run the coroutine task example
+  void runCoroutineExample();
+
+  // Run the save/restore example
+  void runSaveRestoreExample();
+
   // Run all examples
   void run();
 };
\ No newline at end of file
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "core/Components.h"
+#include "core/DungeonGenerator.hpp"
+#include "core/EntityFactory.hpp"
+#include "core/OccupancyGrid.hpp"
+#include "core/SimulationClock.hpp"
+#include "core/SystemScheduler.hpp"
+#include "core/TmxMapLoader.h"
+#include "core/WanderSystem.hpp"
+#include "events/EventBus.h"
+#include "input/InputCommand.hpp"
+#include "navigation/FlowFieldSystem.hpp"
+#include "navigation/HierarchicalPathfinding.hpp"
+#include "navigation/InfluenceMap.hpp"
+#include "navigation/NavGrid.hpp"
+#include "navigation/PathCache.hpp"
+#include "navigation/Pathfinding.hpp"
+#include "replay/EventJournal.hpp"
+#include "scheduler/Scheduler.h"
+#include "scheduler/TimedEventScheduler.h"
+#include "vision/FieldOfViewSystem.hpp"
+#include "vision/OpacityGrid.hpp"
+#include <SDL2/SDL.h>
+#include <chrono>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+class Mob;
+
+namespace Core {
+
+// The game world and its fixed-step tick pipeline, independent of any window,
+// renderer or audio device. CollisionTest drives it from the SDL loop;
+// HeadlessRuntime drives it on its own for benchmarks and replays.
+//
+// Simulation time is the tick count. Game time in milliseconds is derived
+// from it (SimulationClock::MS_PER_TICK per tick), never read from the wall
+// clock, so a tick behaves the same however fast ticks are run.
+class Simulation {
+public:
+  // Share of a tick the schedulers may spend before deferring work
+  static constexpr std::chrono::microseconds SCHEDULER_BUDGET{8000};
+  // Mobs that see the player within this many steps chase it instead of
+  // wandering, and give up once it is further away
+  static constexpr int PURSUIT_RANGE = 8;
+
+  // Outcome of replaying a journal
+  struct ReplayResult {
+    int ticks = 0;
+    int divergedTicks = 0; // Ticks whose event traffic differed
+    int firstDivergence = 0;
+  };
+
+  Simulation();
+
+  Simulation(const Simulation &) = delete;
+  Simulation &operator=(const Simulation &) = delete;
+
+  // Map loader used by TMX scenarios; not needed for dungeon scenarios
+  void setMapLoader(TmxMapLoader *loader) { mapLoader = loader; }
+  // Mob steered by MoveMob commands, if any
+  void setControlledMob(Mob *mob) { controlledMob = mob; }
+
+  // Scenario settings applied by the next resetScenario(); the seed field is
+  // filled in by the reset
+  Replay::ScenarioRecord &getScenario() { return scenario; }
+
+  // Rebuild the world from the current settings with a fresh seed
+  bool resetScenario();
+  // Rebuild the world exactly as described, seed included
+  bool resetScenario(const Replay::ScenarioRecord &settings);
+
+  // Run one live tick with a fresh seed
+  void tick(std::span<const Input::Command> commands);
+  // Run one tick with a given seed, e.g. one read back from a journal
+  void tick(const Replay::TickRecord &record,
+            std::span<const Input::Command> commands);
+
+  // Record seeds, commands, scenario resets and event traffic from now on.
+  // Starts a fresh scenario so the journal can rebuild it.
+  bool startRecording(const std::string &path);
+  void stopRecording() { journalWriter.reset(); }
+  bool isRecording() const { return journalWriter != nullptr; }
+
+  // Run a recorded session to its end as fast as possible, checking that
+  // every tick reproduces the recorded event traffic
+  ReplayResult replay(Replay::JournalReader &reader);
+
+  entt::registry &getRegistry() { return registry; }
+  EventBus &getEventBus() { return eventBus; }
+  entt::dispatcher &getDispatcher() { return dispatcher; }
+  Scheduler &getScheduler() { return scheduler; }
+  TimedEventScheduler &getTimedEvents() { return timedEvents; }
+  const SystemScheduler &getSystems() const { return systems; }
+  const Navigation::NavGrid &getNavGrid() const { return navGrid; }
+  // Colliders by cell, for CollisionSystem::Raycast and HasLineOfSight
+  const OccupancyGrid &getOccupancy() const { return occupancy; }
+  Navigation::Pathfinding &getPathfinding() { return pathfinding; }
+  // Pathfinding with repeated routes served from a cache
+  Navigation::PathCache &getPathCache() { return pathCache; }
+  // For long routes on large maps; builds its graph on the first query
+  Navigation::HierarchicalPathfinding &getHierarchicalPathfinding() {
+    return hierarchicalPathfinding;
+  }
+  const Navigation::FlowFieldSystem &getPlayerField() const {
+    return playerField;
+  }
+  // Set a trace sink here to follow what wandering mobs do
+  Systems::WanderSystem &getWanderSystem() { return wandering; }
+  // Crowd and player influence, for AI that weighs where others are
+  const Navigation::InfluenceMap &getInfluenceMap() const { return influence; }
+  const Vision::OpacityGrid &getOpacityGrid() const { return opacityGrid; }
+  const Vision::FieldOfViewSystem &getFieldOfView() const {
+    return fieldOfView;
+  }
+  int getCurrentTick() const { return currentTick; }
+  // Game time of the last tick in milliseconds
+  Uint32 getGameTime() const { return gameTime; }
+  const TickBudgetReport &getLastBudgetReport() const {
+    return lastBudgetReport;
+  }
+
+private:
+  using WanderView = entt::view<
+      entt::get_t<Components::PositionComponent, Components::WanderComponent>,
+      entt::exclude_t<Components::PursuitTag>>;
+  using PlayerView = entt::view<entt::get_t<const Components::PositionComponent,
+                                            const Components::PlayerMarker>>;
+  using MobView = entt::view<entt::get_t<const Components::PositionComponent,
+                                         const Components::MobTag>>;
+  using BlockerView =
+      entt::view<entt::get_t<const Components::CollisionComponent>>;
+
+  // Systems run by the SystemScheduler each tick. Their parameters declare
+  // the components they touch; taking the registry makes a system exclusive.
+  void inputSystem(entt::registry &);
+  void occupancySystem(BlockerView, PlayerView);
+  void aiLodSystem(entt::registry &);
+  void flowFieldSystem(PlayerView);
+  void fieldOfViewSystem(Vision::FieldOfViewSystem::Viewers viewers);
+  void pursuitSystem(entt::registry &);
+  void wanderSystem(WanderView, BlockerView);
+  void influenceSystem(MobView, PlayerView);
+  void schedulerSystem(entt::registry &);
+
+  void applyCommand(const Input::Command &command);
+  bool buildDungeonScenario();
+  bool buildTmxScenario();
+  void createMob(int x, int y, int number, Uint32 moveCooldownTicks);
+  void subscribeJournal();
+  template <typename Event> void journalEvents(std::span<const Event> events);
+
+  entt::registry registry;
+  EventBus eventBus;
+  entt::dispatcher dispatcher;
+  Scheduler scheduler;
+  TimedEventScheduler timedEvents;
+  SystemScheduler systems;
+  std::span<const Input::Command> tickCommands; // Input of the running tick
+  EntityFactory entityFactory;
+  WalkerDungeonGenerator dungeonGenerator;
+  OccupancyGrid occupancy;     // Rebuilt with every scenario
+  Navigation::NavGrid navGrid; // Rebuilt with every scenario
+  Navigation::Pathfinding pathfinding{navGrid};
+  Navigation::PathCache pathCache{navGrid, pathfinding};
+  Navigation::HierarchicalPathfinding hierarchicalPathfinding{navGrid};
+  Navigation::FlowFieldSystem playerField; // Shared by every pursuing mob
+  Navigation::InfluenceMap influence;
+  Vision::OpacityGrid opacityGrid;         // Rebuilt with every scenario
+  Vision::FieldOfViewSystem fieldOfView;
+  Systems::WanderSystem wandering;
+  TmxMapLoader *mapLoader = nullptr;
+  Mob *controlledMob = nullptr;
+
+  Replay::ScenarioRecord scenario;
+  int currentTick = 0;
+  Uint32 gameTime = 0;
+  TickBudgetReport lastBudgetReport;
+
+  // Record/replay
+  std::mt19937 seedSource{std::random_device()()};
+  std::unique_ptr<Replay::JournalWriter> journalWriter;
+  bool journalSubscribed = false;
+  bool replaying = false;
+  std::vector<std::byte> replayTraffic; // Events produced by a replayed tick
+};
+
+} // namespace Core
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+namespace Core {
+
+// Decides how many simulation ticks a frame runs. The simulation itself only
+// counts ticks; this is the one place the wall clock enters the loop.
+//
+// RealTime accumulates wall time and runs one tick per MS_PER_TICK of it, so
+// the game plays at ~60 ticks per second. FastForward runs ticks back to back
+// for up to one frame's worth of wall time and then lets the frame render,
+// so the simulation goes as fast as the CPU allows while the window stays
+// responsive.
+class SimulationClock {
+public:
+  enum class Mode { RealTime, FastForward };
+
+  static constexpr Uint32 MS_PER_TICK = 16; // ~60 ticks per second
+  // Wall time a fast-forward frame spends ticking before it renders
+  static constexpr Uint32 FAST_FORWARD_FRAME_MS = 16;
+
+  // Whole ticks covering a duration, for converting millisecond tunables
+  static constexpr Uint32 ticksFor(Uint32 ms) {
+    return (ms + MS_PER_TICK - 1) / MS_PER_TICK;
+  }
+
+  Mode getMode() const { return mode; }
+  bool isFastForward() const { return mode == Mode::FastForward; }
+
+  void setMode(Mode newMode) {
+    mode = newMode;
+    // Don't let time banked in one mode turn into a burst in the other
+    accumulator = 0;
+  }
+
+  // Reset to wall time now, e.g. before entering the loop
+  void start(Uint32 wallMs) {
+    lastFrameTime = wallMs;
+    accumulator = 0;
+  }
+
+  // Start a frame at wall time now
+  void beginFrame(Uint32 wallMs) {
+    frameStart = wallMs;
+    ticksThisFrame = 0;
+    if (mode == Mode::RealTime) {
+      accumulator += wallMs - lastFrameTime;
+    }
+    lastFrameTime = wallMs;
+  }
+
+  // True while the current frame should run another tick. Call in a loop
+  // with the current wall time.
+  bool nextTick(Uint32 wallMs) {
+    if (mode == Mode::RealTime) {
+      if (accumulator < MS_PER_TICK) {
+        return false;
+      }
+      accumulator -= MS_PER_TICK;
+    } else if (ticksThisFrame > 0 &&
+               wallMs - frameStart >= FAST_FORWARD_FRAME_MS) {
+      return false;
+    }
+    ticksThisFrame++;
+    return true;
+  }
+
+  int getTicksThisFrame() const { return ticksThisFrame; }
+
+  // Wall time until the next tick is due; zero when fast-forwarding. Lets a
+  // dedicated simulation thread sleep instead of spinning.
+  Uint32 msUntilNextTick() const {
+    if (mode == Mode::FastForward || accumulator >= MS_PER_TICK) {
+      return 0;
+    }
+    return MS_PER_TICK - accumulator;
+  }
+
+private:
+  Mode mode = Mode::RealTime;
+  Uint32 lastFrameTime = 0;
+  Uint32 frameStart = 0;
+  Uint32 accumulator = 0;
+  int ticksThisFrame = 0;
+};
+
+} // namespace Core
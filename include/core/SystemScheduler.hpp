@@ -0,0 +1,79 @@
+#pragma once
+
+#include "core/services/JobSystem.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <entt/entt.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Core {
+
+// Per-system cost, updated every run
+struct SystemTiming {
+  std::string name;
+  std::chrono::nanoseconds last{0};
+  std::chrono::nanoseconds slowest{0};
+  double averageUs = 0.0; // Moving average over roughly the last 64 runs
+  std::size_t runs = 0;
+};
+
+// Runs a tick's systems as an entt::organizer task graph. Each system's
+// component access is derived from its signature: views declare what they
+// read (const) and write, and other non-registry parameters come from the
+// registry context. Systems that take the registry itself are exclusive and
+// act as barriers. Vertices whose dependencies are done run concurrently on
+// the shared JobSystem; the calling thread helps until the graph completes.
+//
+// Systems that run concurrently must not share mutable state outside the
+// registry, such as the EventBus or rand(); such systems should take the
+// registry so they run exclusively.
+class SystemScheduler {
+public:
+  // Runs on the JobSystem registered with entt::locator, creating it if needed
+  SystemScheduler();
+  explicit SystemScheduler(Services::JobSystem &jobs);
+
+  // A free function system:
+  //   systems.add<&moveSystem>("move");
+  // Req overrides or extends the derived access, as for entt::organizer.
+  template <auto Candidate, typename... Req> void add(const char *name) {
+    organizer.emplace<Candidate, Req...>(name);
+    addTiming(name);
+  }
+
+  // A member function system bound to an instance
+  template <auto Candidate, typename... Req, typename Type>
+  void add(Type &instance, const char *name) {
+    organizer.emplace<Candidate, Req...>(instance, name);
+    addTiming(name);
+  }
+
+  void clear();
+
+  // Run every system once, respecting their dependencies
+  void run(entt::registry &registry);
+
+  std::span<const SystemTiming> getTimings() const { return timings; }
+  unsigned getWorkerCount() const { return jobs.getWorkerCount(); }
+
+private:
+  static void execute(void *data, std::size_t index, std::size_t);
+  void build();
+  void addTiming(const char *name);
+
+  entt::organizer organizer;
+  std::vector<entt::organizer::vertex> graph;
+  std::vector<SystemTiming> timings; // In registration order, like graph
+  std::vector<Services::Job> tasks;  // One per vertex
+  std::unique_ptr<std::atomic<std::size_t>[]> pending; // Unfinished inputs
+  Services::JobCounter remaining;
+  entt::registry *current = nullptr;
+  bool dirty = true;
+  Services::JobSystem &jobs;
+};
+
+} // namespace Core
@@ -1,11 +1,81 @@
 #pragma once
 
+#include "core/Components.h"
+#include "core/OccupancyGrid.hpp"
+#include "core/services/JobSystem.hpp"
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <entt/entity/registry.hpp>
+#include <functional>
+#include <utility>
 #include <vector>
 
 namespace Systems {
 
-void WanderSystem(entt::registry &registry, Uint32 currentTime);
+// What a wandering mob did, for an optional trace sink
+struct WanderTrace {
+  enum class Kind {
+    Turned,  // Picked a new direction
+    Blocked, // Tried to step into an occupied cell
+    Moved,
+    Pursuing // Saw the player and stopped wandering to chase it
+  };
+  Kind kind;
+  entt::entity entity;
+  int x; // Cell before the step
+  int y;
+  int direction; // 0 = up, 1 = right, 2 = down, 3 = left; -1 if none
+};
 
-} // namespace Systems
\ No newline at end of file
+// Moves mobs with a WanderComponent one cell at a time in a random
+// direction, turning when blocked and now and then at random. Randomness
+// comes from each mob's own WanderComponent::rngState, so a mob's choices
+// don't depend on which thread makes them or what else drew numbers.
+//
+// A pass runs in two phases. Mobs due to move pick a direction and target
+// cell in parallel chunks, touching only their own components. The moves
+// are then applied one by one in view order against the OccupancyGrid, so
+// two mobs never end up in one cell and the outcome is the same on every
+// run. Cooldowns are measured in simulation ticks.
+class WanderSystem {
+public:
+  using TraceSink = std::function<void(const WanderTrace &)>;
+
+  // Receives every turn, block and move in the order they are applied, and
+  // every mob that starts pursuing; no sink, no tracing cost
+  void setTraceSink(TraceSink sink) { trace = std::move(sink); }
+  // A sink that logs each trace to std::cout
+  static void printTrace(const WanderTrace &trace);
+  // Pass a trace from outside the pass, such as pursuit taking a mob over,
+  // to the sink
+  void report(const WanderTrace &event) const {
+    if (trace) {
+      trace(event);
+    }
+  }
+
+  void update(entt::registry &registry, Core::OccupancyGrid &occupancy,
+              Uint32 currentTick, Core::Services::JobSystem &jobs);
+
+  // A well-mixed, non-zero starting state for one mob's stream
+  static std::uint32_t seedFor(std::uint32_t seed, std::uint32_t stream);
+  // Advance a stream (xorshift32) and return its next value
+  static std::uint32_t nextRandom(std::uint32_t &state);
+
+private:
+  struct Candidate {
+    entt::entity entity;
+    Components::PositionComponent *pos;
+    Components::WanderComponent *wander;
+    int toX = 0;
+    int toY = 0;
+    bool wallAhead = false; // Target holds a static collider
+    bool turned = false;    // Picked a new direction before stepping
+    bool turnAfter = false; // Drop the direction after a successful step
+  };
+
+  std::vector<Candidate> candidates; // Reused by every pass
+  TraceSink trace;
+};
+
+} // namespace Systems
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <entt/entt.hpp>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Core {
+namespace Services {
+
+class JobSystem;
+struct Job;
+
+// Counts unfinished jobs. Jobs queued behind a counter start once it drops to
+// zero, which is how dependencies are expressed. A counter must not be reused
+// for a new batch until its previous batch has been waited on.
+class JobCounter {
+public:
+  std::size_t getValue() const {
+    return value.load(std::memory_order_acquire);
+  }
+  bool isDone() const { return getValue() == 0; }
+
+private:
+  friend class JobSystem;
+
+  std::atomic<std::size_t> value{0};
+  mutable std::mutex waitersMutex; // Also held while finishing the last job
+  std::vector<Job *> waiters; // Jobs waiting for this to reach zero
+};
+
+// A function pointer over a range plus its data; queueing never allocates.
+// Jobs are not copied by the system, so they must stay alive until their
+// counter reaches zero.
+struct Job {
+  void (*function)(void *data, std::size_t begin, std::size_t end) = nullptr;
+  void *data = nullptr;
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  JobCounter *counter = nullptr; // Decremented when the job finishes
+};
+
+// Shared worker threads for anything that can run in parallel: system graphs,
+// generation, AI, render command building. Each worker owns a Chase-Lev deque:
+// it pushes and pops the newest job at one end without locking while idle
+// workers steal the oldest job from the other. Threads outside the pool queue
+// into a shared inbox and help run jobs while they wait, so the main or
+// simulation thread never just blocks on the workers.
+//
+// One instance is shared through entt::locator<JobSystem>; emplace it before
+// creating anything that uses it, e.g. at the start of main.
+class JobSystem {
+public:
+  // workerCount threads in addition to the threads that wait on jobs
+  explicit JobSystem(unsigned workerCount = defaultWorkerCount());
+  ~JobSystem();
+
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+
+  // Queue jobs, adding them to their counters
+  void run(std::span<Job> jobs);
+  void run(Job &job) { run(std::span<Job>(&job, 1)); }
+
+  // Queue jobs once dependency reaches zero
+  void runAfter(JobCounter &dependency, std::span<Job> jobs);
+
+  // Run queued jobs on the calling thread until the counter reaches zero
+  void wait(const JobCounter &counter);
+
+  // Call function(begin, end) over chunks of [0, count) and wait for them.
+  // A zero grain picks one that gives every thread a few chunks to balance.
+  template <typename Func>
+  void parallelFor(std::size_t count, Func &&function, std::size_t grain = 0) {
+    if (grain == 0) {
+      grain = defaultGrain(count);
+    }
+    if (count <= grain) {
+      if (count > 0) {
+        function(std::size_t{0}, count);
+      }
+      return;
+    }
+
+    using Function = std::remove_reference_t<Func>;
+    std::vector<Job> jobs((count + grain - 1) / grain);
+    JobCounter counter;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+      jobs[i].function = [](void *data, std::size_t begin, std::size_t end) {
+        (*static_cast<Function *>(data))(begin, end);
+      };
+      jobs[i].data = const_cast<void *>(
+          static_cast<const void *>(std::addressof(function)));
+      jobs[i].begin = i * grain;
+      jobs[i].end = std::min(count, jobs[i].begin + grain);
+      jobs[i].counter = &counter;
+    }
+    run(jobs);
+    wait(counter);
+  }
+
+  // Call function(entity) for every entity in an EnTT view, chunked over the
+  // view's leading storage. Components are fetched with view.get; writes are
+  // safe as long as each entity only touches its own components.
+  template <typename View, typename Func>
+    requires requires(const View &view) { view.handle(); }
+  void parallelFor(const View &view, Func &&function, std::size_t grain = 0) {
+    const auto *storage = view.handle();
+    if (!storage) {
+      return;
+    }
+    parallelFor(
+        storage->size(),
+        [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i) {
+            const auto entity = storage->data()[i];
+            if (view.contains(entity)) {
+              function(entity);
+            }
+          }
+        },
+        grain);
+  }
+
+  unsigned getWorkerCount() const {
+    return static_cast<unsigned>(workers.size());
+  }
+
+  // Leave one core for the thread that waits on the jobs
+  static unsigned defaultWorkerCount();
+
+private:
+  // Chase-Lev work-stealing deque with a fixed capacity
+  class WorkQueue {
+  public:
+    static constexpr std::int64_t CAPACITY = 4096;
+
+    WorkQueue();
+    bool push(Job *job); // Owner only; false when full
+    Job *pop();          // Owner only, newest first
+    Job *steal();        // Any thread, oldest first
+
+  private:
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    std::unique_ptr<std::atomic<Job *>[]> slots;
+  };
+
+  void workerLoop(std::size_t self);
+  void push(Job *job);
+  Job *take();
+  void execute(Job *job);
+  void finish(JobCounter &counter);
+  std::size_t defaultGrain(std::size_t count) const;
+
+  static constexpr std::size_t MIN_GRAIN = 32;
+
+  std::vector<std::unique_ptr<WorkQueue>> queues; // One per worker
+  std::vector<std::thread> workers;
+
+  // Jobs queued by threads outside the pool
+  std::mutex inboxMutex;
+  std::deque<Job *> inbox;
+
+  std::atomic<std::size_t> queued{0};
+  std::atomic<unsigned> sleeping{0};
+  std::atomic<bool> stopping{false};
+  std::mutex sleepMutex;
+  std::condition_variable wake;
+};
+
+} // namespace Services
+} // namespace Core
@@ -10,7 +10,8 @@
 class WalkerDungeon {
 public:
   WalkerDungeon(int totalFloorCount, int minHall, int maxHall, int roomDim,
-                int tileWidth = 16, int tileHeight = 16);
+                int tileWidth = 16, int tileHeight = 16,
+                unsigned int seed = std::random_device()());
 
   // Dungeon generation functions
   void GenerateRandomWalker();
@@ -1,27 +1,259 @@
 #pragma once
 
 #include "GameEvent.h"
-#include <functional>
-#include <unordered_map>
+#include <algorithm>
+#include <entt/entt.hpp>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// Compile-time typed event bus. Each event type gets its own contiguous array
+// of entt::delegate handlers, found by a dense per-type index, so publish is
+// an index lookup plus direct calls with no hashing, std::function or
+// downcasts. Like the rest of the game loop it is single-threaded.
+//
+// Events can also be deferred: enqueue() appends to a per-type buffer and
+// flush() delivers everything queued since the last flush at a defined sync
+// point, so handlers don't run in the middle of system iteration. Batch
+// handlers receive the whole buffer as one span. Types registered with
+// coalesce() collapse queued events sharing a key to the last one per flush.
 class EventBus {
 public:
-  using Handler = std::function<void(const GameEvent &)>;
+  template <typename Event> using Handler = entt::delegate<void(const Event &)>;
+  template <typename Event>
+  using BatchHandler = entt::delegate<void(std::span<const Event>)>;
 
-  void subscribe(GameEventType type, Handler handler) {
-    handlers[type].push_back(handler);
+  // Subscribe a free function or captureless lambda:
+  //   bus.subscribe<PlayerMovedEvent, &onPlayerMoved>();
+  template <typename Event, auto Candidate> void subscribe() {
+    Handler<Event> handler;
+    handler.template connect<Candidate>();
+    assure<Event>().push_back(handler);
   }
 
-  void publish(const GameEvent &event) const {
-    auto it = handlers.find(event.getType());
-    if (it != handlers.end()) {
-      for (const auto &handler : it->second) {
-        handler(event);
-      }
+  // Subscribe a member function bound to an instance:
+  //   bus.subscribe<PlayerMovedEvent, &Hud::onPlayerMoved>(hud);
+  template <typename Event, auto Candidate, typename Type>
+  void subscribe(Type &instance) {
+    Handler<Event> handler;
+    handler.template connect<Candidate>(instance);
+    assure<Event>().push_back(handler);
+  }
+
+  // Subscribe a handler that receives events as a span: all events flushed
+  // in one go, or a single-element span for immediate publishes
+  template <typename Event, auto Candidate> void subscribeBatch() {
+    BatchHandler<Event> handler;
+    handler.template connect<Candidate>();
+    assurePool<Event>().batchHandlers.push_back(handler);
+  }
+
+  template <typename Event, auto Candidate, typename Type>
+  void subscribeBatch(Type &instance) {
+    BatchHandler<Event> handler;
+    handler.template connect<Candidate>(instance);
+    assurePool<Event>().batchHandlers.push_back(handler);
+  }
+
+  template <typename Event, auto Candidate> void unsubscribe() {
+    Handler<Event> handler;
+    handler.template connect<Candidate>();
+    remove<Event>(handler);
+  }
+
+  template <typename Event, auto Candidate, typename Type>
+  void unsubscribe(Type &instance) {
+    Handler<Event> handler;
+    handler.template connect<Candidate>(instance);
+    remove<Event>(handler);
+  }
+
+  // Opt a type into coalescing. KeyOf maps an event to a key (comparable
+  // with < and ==), e.g. its entity; at each flush only the last queued
+  // event per key is delivered, in the order of those last events.
+  // Immediate publish() calls are not affected.
+  template <typename Event, auto KeyOf> void coalesce() {
+    assurePool<Event>().coalescer =
+        std::make_unique<Coalescer<Event, KeyOf>>();
+  }
+
+  // Deliver an event to its handlers right away
+  template <typename Event> void publish(const Event &event) const {
+    const std::size_t index = typeIndex<Event>();
+    if (index >= pools.size() || !pools[index]) {
+      return;
+    }
+
+    static_cast<const Pool<Event> &>(*pools[index])
+        .deliver(std::span<const Event>(&event, 1));
+  }
+
+  // Queue an event for the next flush()
+  template <typename Event> void enqueue(const Event &event) {
+    Pool<Event> &pool = assurePool<Event>();
+    if (pool.pending.empty()) {
+      dirty.push_back(pool.index);
     }
+    pool.pending.push_back(event);
+  }
+
+  // Queue a run of events of one type for the next flush()
+  template <typename Event> void enqueue(std::span<const Event> events) {
+    if (events.empty()) {
+      return;
+    }
+    Pool<Event> &pool = assurePool<Event>();
+    if (pool.pending.empty()) {
+      dirty.push_back(pool.index);
+    }
+    pool.pending.insert(pool.pending.end(), events.begin(), events.end());
+  }
+
+  // Deliver queued events, type by type in the order each type was first
+  // queued. All buffers are swapped before any delivery and keep their
+  // capacity, so steady-state flushing doesn't allocate. Events queued by
+  // handlers during a flush are delivered by the next one.
+  void flush() {
+    std::swap(dirty, flushing);
+    for (std::size_t index : flushing) {
+      pools[index]->swapBuffers();
+    }
+    for (std::size_t index : flushing) {
+      pools[index]->deliverSwapped();
+    }
+    flushing.clear();
+  }
+
+  template <typename Event> std::size_t pendingCount() const {
+    const std::size_t index = typeIndex<Event>();
+    if (index >= pools.size() || !pools[index]) {
+      return 0;
+    }
+    return static_cast<const Pool<Event> &>(*pools[index]).pending.size();
+  }
+
+  template <typename Event> std::size_t handlerCount() const {
+    const std::size_t index = typeIndex<Event>();
+    if (index >= pools.size() || !pools[index]) {
+      return 0;
+    }
+    return static_cast<const Pool<Event> &>(*pools[index]).handlers.size();
   }
 
 private:
-  std::unordered_map<GameEventType, std::vector<Handler>> handlers;
-};
\ No newline at end of file
+  struct PoolBase {
+    explicit PoolBase(std::size_t index) : index(index) {}
+    virtual ~PoolBase() = default;
+    virtual void swapBuffers() = 0;
+    virtual void deliverSwapped() = 0;
+
+    std::size_t index;
+  };
+
+  template <typename Event> struct CoalescerBase {
+    virtual ~CoalescerBase() = default;
+    virtual void apply(std::vector<Event> &events) = 0;
+  };
+
+  // Sorts (key, index) pairs to find the last event per key, then compacts
+  // the buffer in place. The scratch buffers are reused across flushes.
+  template <typename Event, auto KeyOf>
+  struct Coalescer : CoalescerBase<Event> {
+    using Key = std::decay_t<decltype(KeyOf(std::declval<const Event &>()))>;
+
+    void apply(std::vector<Event> &events) override {
+      if (events.size() < 2) {
+        return;
+      }
+
+      order.clear();
+      for (std::size_t i = 0; i < events.size(); ++i) {
+        order.emplace_back(KeyOf(events[i]), i);
+      }
+      std::sort(order.begin(), order.end());
+
+      keep.assign(events.size(), false);
+      for (std::size_t i = 0; i < order.size(); ++i) {
+        if (i + 1 == order.size() || !(order[i].first == order[i + 1].first)) {
+          keep[order[i].second] = true;
+        }
+      }
+
+      std::size_t out = 0;
+      for (std::size_t i = 0; i < events.size(); ++i) {
+        if (keep[i]) {
+          if (out != i) {
+            events[out] = std::move(events[i]);
+          }
+          out++;
+        }
+      }
+      events.erase(events.begin() + out, events.end());
+    }
+
+    std::vector<std::pair<Key, std::size_t>> order;
+    std::vector<bool> keep;
+  };
+
+  template <typename Event> struct Pool : PoolBase {
+    using PoolBase::PoolBase;
+
+    void deliver(std::span<const Event> events) const {
+      for (const auto &handler : batchHandlers) {
+        handler(events);
+      }
+      for (const auto &handler : handlers) {
+        for (const auto &event : events) {
+          handler(event);
+        }
+      }
+    }
+
+    void swapBuffers() override { std::swap(pending, delivering); }
+
+    void deliverSwapped() override {
+      if (coalescer) {
+        coalescer->apply(delivering);
+      }
+      deliver(delivering);
+      delivering.clear();
+    }
+
+    std::vector<Handler<Event>> handlers;
+    std::vector<BatchHandler<Event>> batchHandlers;
+    std::vector<Event> pending;    // Filled by enqueue()
+    std::vector<Event> delivering; // Drained by flush()
+    std::unique_ptr<CoalescerBase<Event>> coalescer;
+  };
+
+  template <typename Event> static std::size_t typeIndex() {
+    return entt::type_index<Event>::value();
+  }
+
+  template <typename Event> Pool<Event> &assurePool() {
+    const std::size_t index = typeIndex<Event>();
+    if (index >= pools.size()) {
+      pools.resize(index + 1);
+    }
+    if (!pools[index]) {
+      pools[index] = std::make_unique<Pool<Event>>(index);
+    }
+    return static_cast<Pool<Event> &>(*pools[index]);
+  }
+
+  template <typename Event> std::vector<Handler<Event>> &assure() {
+    return assurePool<Event>().handlers;
+  }
+
+  template <typename Event> void remove(const Handler<Event> &handler) {
+    auto &handlers = assure<Event>();
+    handlers.erase(std::remove(handlers.begin(), handlers.end(), handler),
+                   handlers.end());
+  }
+
+  std::vector<std::unique_ptr<PoolBase>> pools; // Indexed by typeIndex
+  std::vector<std::size_t> dirty;    // Pools with queued events
+  std::vector<std::size_t> flushing; // Pools being delivered by flush()
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "EventBus.h"
+#include <cassert>
+#include <cstddef>
+#include <entt/entt.hpp>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Multi-producer, single-consumer event channel for publishing from worker
+// threads. Every producer owns one slot (its worker index) and only ever
+// appends to that slot's buffers, so publish takes no lock and uses no
+// atomics. At the tick boundary, after the workers have been joined, the
+// consumer merges the slots into an EventBus or entt::dispatcher in slot
+// order; within a slot, type by type in the order each type was first
+// published, and in publish order within a type. Order across types isn't
+// kept, as both sinks deliver type by type anyway. Delivery is still
+// deterministic regardless of thread timing.
+class EventChannel {
+public:
+  explicit EventChannel(std::size_t producerCount = 1) : slots(producerCount) {}
+
+  EventChannel(const EventChannel &) = delete;
+  EventChannel &operator=(const EventChannel &) = delete;
+
+  std::size_t producerCount() const { return slots.size(); }
+
+  // Producer side. Each slot must be used by at most one thread at a time.
+  template <typename Event>
+  void publish(std::size_t producer, const Event &event) {
+    assert(producer < slots.size());
+    slots[producer].buffer<Event>().push_back(event);
+  }
+
+  // Consumer side: move everything into the bus's deferred queues; the
+  // events are delivered by the next EventBus::flush()
+  void drainTo(EventBus &bus) {
+    for (auto &slot : slots) {
+      for (BufferBase *buffer : slot.used) {
+        buffer->drainTo(bus);
+      }
+      slot.used.clear();
+    }
+  }
+
+  // Consumer side: enqueue everything on an entt dispatcher
+  void drainTo(entt::dispatcher &dispatcher) {
+    for (auto &slot : slots) {
+      for (BufferBase *buffer : slot.used) {
+        buffer->drainTo(dispatcher);
+      }
+      slot.used.clear();
+    }
+  }
+
+  std::size_t pendingCount() const {
+    std::size_t count = 0;
+    for (const auto &slot : slots) {
+      for (const BufferBase *buffer : slot.used) {
+        count += buffer->size();
+      }
+    }
+    return count;
+  }
+
+private:
+  struct BufferBase {
+    virtual ~BufferBase() = default;
+    virtual void drainTo(EventBus &bus) = 0;
+    virtual void drainTo(entt::dispatcher &dispatcher) = 0;
+    virtual std::size_t size() const = 0;
+  };
+
+  template <typename Event> struct Buffer : BufferBase {
+    void drainTo(EventBus &bus) override {
+      bus.enqueue(std::span<const Event>(events));
+      events.clear();
+    }
+
+    void drainTo(entt::dispatcher &dispatcher) override {
+      for (const auto &event : events) {
+        dispatcher.enqueue(event);
+      }
+      events.clear();
+    }
+
+    std::size_t size() const override { return events.size(); }
+
+    std::vector<Event> events;
+  };
+
+  // Aligned so producers on different cores don't share cache lines
+  struct alignas(64) Slot {
+    template <typename Event> std::vector<Event> &buffer() {
+      // type_hash is computed from the type's name at compile time, unlike
+      // type_index, whose first use bumps a global non-atomic counter and
+      // so isn't safe from workers
+      constexpr entt::id_type id = entt::type_hash<Event>::value();
+      BufferBase *found = nullptr;
+      for (auto &[key, buffer] : buffers) {
+        if (key == id) {
+          found = buffer.get();
+          break;
+        }
+      }
+      if (!found) {
+        found = buffers.emplace_back(id, std::make_unique<Buffer<Event>>())
+                    .second.get();
+      }
+
+      auto &events = static_cast<Buffer<Event> &>(*found).events;
+      if (events.empty()) {
+        used.push_back(found);
+      }
+      return events;
+    }
+
+    // By entt::type_hash; a slot sees few event types, so a scan is enough
+    std::vector<std::pair<entt::id_type, std::unique_ptr<BufferBase>>>
+        buffers;
+    std::vector<BufferBase *> used; // Buffers with events, first-use order
+  };
+
+  std::vector<Slot> slots;
+};
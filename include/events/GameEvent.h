@@ -1,5 +1,7 @@
 #pragma once
 
+#include <entt/entt.hpp>
+
 // Define event types
 enum class GameEventType {
   PLAYER_MOVED,
@@ -10,34 +12,23 @@ enum class GameEventType {
   MOB_MOVED
 };
 
-// Base event class
-class GameEvent {
-public:
-  explicit GameEvent(GameEventType type) : type(type) {}
-  virtual ~GameEvent() = default;
-
-  GameEventType getType() const { return type; }
-
-private:
-  GameEventType type;
-};
+// Events are plain structs dispatched by type through EventBus. The `type`
+// tag is kept for logging and serialization.
 
 // Player movement event
-class PlayerMovedEvent : public GameEvent {
-public:
-  PlayerMovedEvent(int newX, int newY)
-      : GameEvent(GameEventType::PLAYER_MOVED), newX(newX), newY(newY) {}
+struct PlayerMovedEvent {
+  static constexpr GameEventType type = GameEventType::PLAYER_MOVED;
 
+  entt::entity entity;
   int newX;
   int newY;
 };
 
 // Mob movement event
-class MobMovedEvent : public GameEvent {
-public:
-  MobMovedEvent(int newX, int newY)
-      : GameEvent(GameEventType::MOB_MOVED), newX(newX), newY(newY) {}
+struct MobMovedEvent {
+  static constexpr GameEventType type = GameEventType::MOB_MOVED;
 
+  entt::entity entity;
   int newX;
   int newY;
-};
\ No newline at end of file
+};
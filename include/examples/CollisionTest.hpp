@@ -3,23 +3,31 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
+#include <atomic>
 #include <entt/entt.hpp>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "core/Components.h"
 #include "core/Constants.h"
-#include "core/DungeonGenerator.hpp"
-#include "core/EntityFactory.hpp"
 #include "core/GameManager.h"
 #include "core/GraphicsContext.hpp"
 #include "core/Mob.h"
-#include "events/EventBus.h"
+#include "core/Simulation.hpp"
+#include "core/SimulationClock.hpp"
 #include "events/GameEvent.h"
 #include "input/InputHandler.hpp"
+#include "rendering/RenderSnapshot.hpp"
 #include "rendering/Renderer.hpp"
+#include "rendering/TripleBuffer.hpp"
+#include "scheduler/SchedulerMetrics.h"
 #include "ui/EntityInspectorWindow.hpp"
+#include "ui/InfluenceMapWindow.hpp"
 #include "ui/PerformanceWindow.hpp"
+#include "ui/SchedulerMetricsWindow.hpp"
 #include "ui/TmxLoaderWindow.hpp"
 #include "ui/WalkerDungeonWindow.hpp"
 
@@ -38,12 +46,30 @@ public:
   void setupTestScenario();
   void regenerateDungeon();
 
+  // Record seeds, input commands and event traffic of this session.
+  // Recordings are replayed by the headless runtime.
+  bool startRecording(const std::string &path);
+
+  // Run ticks back to back instead of at 60 per second
+  void setFastForward(bool enabled);
+  // Run the simulation on its own thread; call before run()
+  void setThreaded(bool threaded) { m_threaded = threaded; }
+
 private:
+  // What the simulation hands to the render side after its ticks
+  struct FrameSnapshot {
+    Rendering::RenderSnapshot render;
+    TickBudgetReport budget;
+  };
+
   void setupEventHandlers();
   bool loadTilesets();
-  bool loadTmxMap();
   void handleInput();
+  void stepSimulation();
+  void simulationLoop();
+  void stopSimulationThread();
   void tickUpdate();
+  void publishSnapshot();
   void renderFrame();
   void updateViewportPosition();
 
@@ -53,58 +79,64 @@ private:
   static constexpr int VIEWPORT_WIDTH = Constants::Viewport::VIEWPORT_WIDTH;
   static constexpr int VIEWPORT_HEIGHT = Constants::Viewport::VIEWPORT_HEIGHT;
 
-  // Core systems
-  entt::registry m_registry;
+  // Core systems. The simulation owns the world and its tick pipeline;
+  // this class adds the window, rendering, input and tools around it.
+  Core::Simulation m_simulation;
+  Core::SimulationClock m_clock;
   std::unique_ptr<Core::GraphicsContext> m_graphicsContext;
   GameManager m_gameManager;
-  std::unique_ptr<Core::EntityFactory> m_entityFactory;
-  std::unique_ptr<Core::WalkerDungeonGenerator> m_dungeonGenerator;
 
   // Viewport tracking
   SDL_Rect m_viewport;      // Current viewport rectangle
   int m_currentWindowWidth; // Track current window size for resizing
   int m_currentWindowHeight;
 
+  // Scheduler instrumentation
+  SchedulerMetrics m_schedulerMetrics{"Action Scheduler"};
+  SchedulerMetrics m_timedEventMetrics{"Timed Events"};
+
   // UI components
   std::unique_ptr<UI::PerformanceWindow> m_performanceWindow;
+  std::unique_ptr<UI::SchedulerMetricsWindow> m_schedulerMetricsWindow;
   std::unique_ptr<UI::EntityInspectorWindow> m_entityInspector;
   std::unique_ptr<UI::TmxLoaderWindow> m_tmxLoader;
   std::unique_ptr<UI::WalkerDungeonWindow> m_walkerDungeon;
+  std::unique_ptr<UI::InfluenceMapWindow> m_influenceMap;
 
   // Rendering and input
   std::unique_ptr<Rendering::Renderer> m_renderer;
   std::unique_ptr<Input::InputHandler> m_inputHandler;
-  EventBus m_eventBus;
+
+  // Simulation/render handoff. Ticks and debug tools that touch the live
+  // registry hold m_worldMutex; sprite drawing works from snapshots only, so
+  // rendering and presenting never wait for a tick and vice versa.
+  Rendering::TripleBuffer<FrameSnapshot> m_snapshots;
+  std::mutex m_worldMutex;
+  std::mutex m_inboxMutex;
+  std::vector<Input::Command> m_commandInbox; // Guarded by m_inboxMutex
+  std::vector<Input::Command> m_tickCommands; // Owned by the simulation side
+  std::thread m_simulationThread;
+  std::atomic<bool> m_simulationRunning{false};
+  std::atomic<bool> m_fastForward{false};
+  bool m_threaded = false;
 
   // Game state
   std::vector<SDL_Rect> m_collisionObjects;
   bool m_running = true;
-  Uint32 m_lastFrameTime = 0;
-  Uint32 m_lastTickTime = 0;
-  Uint32 m_accumulator = 0;
-  int m_currentTick = 0;
 
   // UI visibility flags
   bool m_showPerformanceWindow;
+  bool m_showSchedulerMetrics;
   bool m_showEntityInspector;
   bool m_showTmxLoader;
   bool m_showWalkerDungeon;
-  bool m_usingDungeonGenerator;
-
-  // Dungeon generation parameters
-  int m_totalFloorCount;
-  int m_minHall;
-  int m_maxHall;
-  int m_roomDim;
-  int m_tileWidth;
-  int m_tileHeight;
+  bool m_showInfluenceMap;
 
   // Constants
   static constexpr float DEFAULT_ZOOM = 1.0f;
   static constexpr float MIN_ZOOM = 0.1f;
   static constexpr float MAX_ZOOM = 4.0f;
   static constexpr float ZOOM_SPEED = 0.1f;
-  static constexpr Uint32 MS_PER_TICK = 16; // ~60 FPS
   static constexpr float TICKS_PER_SECOND = 60.0f;
 };
 
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Input {
+
+// A gameplay action decoded from raw input. Live input and journal replay
+// both apply commands through InputHandler::execute, so a recorded session
+// can be fed back without SDL events.
+struct Command {
+  enum class Type : std::uint8_t { MovePlayer, MoveMob };
+
+  Type type;
+  std::int8_t dx;
+  std::int8_t dy;
+};
+
+} // namespace Input
@@ -1,20 +1,28 @@
 #pragma once
 
-#include "../core/CollisionSystem.h"
 #include "../core/GameManager.h"
 #include "../core/Mob.h"
 #include "../events/GameEvent.h"
+#include "InputCommand.hpp"
 #include <SDL2/SDL.h>
 #include <entt/entt.hpp>
+#include <vector>
 
 namespace Input {
 
 class InputHandler {
 public:
-  InputHandler(GameManager *gameManager, EventBus &eventBus);
+  explicit InputHandler(GameManager *gameManager);
   ~InputHandler() = default;
 
   bool handleInput(SDL_Event &e, entt::registry &registry, Mob *mob);
+
+  // Movement keys are turned into commands instead of being applied on the
+  // spot; Core::Simulation applies them at the start of its next tick
+  const std::vector<Command> &getPendingCommands() const {
+    return m_pendingCommands;
+  }
+  void clearPendingCommands() { m_pendingCommands.clear(); }
   void setZoomConstraints(float minZoom, float maxZoom) {
     m_minZoom = minZoom;
     m_maxZoom = maxZoom;
@@ -25,11 +33,9 @@ public:
 private:
   bool handleKeyboardInput(SDL_Event &e, entt::registry &registry, Mob *mob);
   bool handleMouseInput(SDL_Event &e);
-  void handlePlayerMovement(entt::registry &registry, int dx, int dy);
-  void handleMobMovement(Mob *mob, int dx, int dy);
 
   GameManager *m_gameManager;
-  EventBus &m_eventBus;
+  std::vector<Command> m_pendingCommands;
   float m_currentZoom{4.0f};
   float m_minZoom{1.0f};
   float m_maxZoom{4.0f};
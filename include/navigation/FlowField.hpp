@@ -0,0 +1,54 @@
+#pragma once
+
+#include "navigation/NavGrid.hpp"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Navigation {
+
+// Step distance from every walkable cell to the nearest of a set of goals,
+// plus the direction of the first step along a shortest route. Any number of
+// agents heading for the same goals share one field, and each picks its next
+// step with a single array read.
+class FlowField {
+public:
+  static constexpr std::uint16_t UNREACHABLE = 0xFFFF;
+  static constexpr std::uint8_t NO_STEP = 0xFF;
+
+  struct Cell {
+    int x;
+    int y;
+  };
+
+  // Breadth-first from all goals at once, one bucket per distance. The
+  // buckets and field arrays are reused, so recomputing doesn't allocate
+  // unless the grid grew.
+  void compute(const NavGrid &grid, std::span<const Cell> goals);
+
+  std::uint16_t getDistance(int x, int y) const {
+    return grid && grid->contains(x, y) ? distance[grid->toIndex(x, y)]
+                                        : UNREACHABLE;
+  }
+
+  // First step from (x, y) towards the nearest goal. Directions follow
+  // WanderComponent: 0 = up, 1 = right, 2 = down, 3 = left; NO_STEP at a
+  // goal or where no goal is reachable.
+  std::uint8_t getDirection(int x, int y) const {
+    return grid && grid->contains(x, y) ? direction[grid->toIndex(x, y)]
+                                        : NO_STEP;
+  }
+
+  // Offsets of a direction
+  static constexpr int DX[4] = {0, 1, 0, -1};
+  static constexpr int DY[4] = {-1, 0, 1, 0};
+
+private:
+  const NavGrid *grid = nullptr;
+  std::vector<std::uint16_t> distance;
+  std::vector<std::uint8_t> direction;
+  std::vector<int> bucket;     // Cells at the distance being expanded
+  std::vector<int> nextBucket; // Cells one step further
+};
+
+} // namespace Navigation
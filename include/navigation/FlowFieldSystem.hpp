@@ -0,0 +1,32 @@
+#pragma once
+
+#include "navigation/FlowField.hpp"
+#include "navigation/NavGrid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace Navigation {
+
+// Keeps a FlowField towards every PlayerMarker entity. The field is only
+// recomputed when a player changes cell or the grid is rebuilt, so however
+// many mobs give chase, pursuit costs one field per player move.
+class FlowFieldSystem {
+public:
+  // Returns true if the field was recomputed
+  bool update(const entt::registry &registry, const NavGrid &grid);
+
+  const FlowField &getField() const { return field; }
+  std::size_t getRecomputeCount() const { return recomputes; }
+
+private:
+  FlowField field;
+  std::vector<FlowField::Cell> goals;
+  std::vector<FlowField::Cell> currentGoals;
+  const NavGrid *fieldGrid = nullptr;
+  std::uint32_t gridVersion = 0;
+  std::size_t recomputes = 0;
+};
+
+} // namespace Navigation
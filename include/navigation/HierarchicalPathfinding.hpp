@@ -0,0 +1,129 @@
+#pragma once
+
+#include "core/Components.h"
+#include "navigation/NavGrid.hpp"
+#include "navigation/Pathfinding.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Navigation {
+
+// HPA*: the grid is cut into CLUSTER_SIZE square clusters, and the cells
+// where a cluster's border can be crossed become nodes of a small abstract
+// graph. Distances between the nodes of a cluster are cached, so a long
+// query searches the abstract graph instead of the grid and yields a coarse
+// route of border crossings. The cells of each leg are refined only when the
+// agent gets there.
+//
+// The graph follows the grid: when cells change, through a hot reload or
+// digging, the next query rebuilds only the clusters whose cells changed and
+// the borders they share with their neighbours.
+//
+// Routes are near-optimal rather than shortest. Like Pathfinding, an
+// instance is single-threaded.
+class HierarchicalPathfinding {
+public:
+  static constexpr int CLUSTER_SIZE = 16;
+
+  explicit HierarchicalPathfinding(const NavGrid &grid)
+      : grid(grid), refiner(grid) {}
+
+  // Route from start to goal. path.waypoints holds the coarse route ending
+  // at goal and path.steps the cells of its first leg.
+  bool findPath(int startX, int startY, int goalX, int goalY,
+                Components::PathComponent &path);
+
+  // Refine the leg from (x, y) to the next waypoint into path.steps. Call
+  // when the steps run out; false once no waypoints remain.
+  bool refineNext(Components::PathComponent &path, int x, int y);
+
+  // Bring the abstract graph up to date with the grid. Queries do this
+  // themselves; call it to pay for a rebuild at a convenient time.
+  void update();
+
+  std::size_t getClusterCount() const { return clusters.size(); }
+  std::size_t getNodeCount() const { return nodes.size() - freeNodes.size(); }
+  // Clusters rebuilt by the last update that changed anything
+  std::size_t getLastRebuilt() const { return lastRebuilt; }
+  // Abstract nodes expanded by the last query
+  std::size_t getLastExpanded() const { return lastExpanded; }
+
+private:
+  struct Edge {
+    int to;
+    int cost;
+  };
+
+  // A border cell paired with the cell across the border
+  struct Node {
+    int cell = -1;
+    int cluster = -1;
+    int border = -1;
+    int peer = -1;           // Node on the other side, one step away
+    std::vector<Edge> edges; // Cached distances within the cluster
+    bool alive = false;
+  };
+
+  struct Cluster {
+    int x0, y0, x1, y1; // Inclusive cell bounds
+    std::vector<int> nodes;
+  };
+
+  struct SearchNode {
+    std::uint32_t generation = 0;
+    bool closed = false;
+    int cost = 0;
+    int parent = -1;
+  };
+
+  struct OpenEntry {
+    int estimate;
+    int cost;
+    int node;
+  };
+
+  void rebuildAll();
+  void rebuildClusters(const std::vector<int> &dirty);
+  // Borders are numbered cluster * 2, plus 1 for the south border rather
+  // than the east one
+  void clearBorder(int border);
+  void buildBorder(int border);
+  void addEntrance(int border, int cellA, int clusterA, int cellB,
+                   int clusterB);
+  void linkCluster(int cluster);
+  void distancesFrom(int cluster, int x, int y);
+  int distanceTo(int cluster, int cell) const;
+  int clusterOf(int x, int y) const;
+  bool route(int startX, int startY, int goalX, int goalY,
+             Components::PathComponent &path);
+
+  const NavGrid &grid;
+  Pathfinding refiner;
+
+  int clustersX = 0;
+  int clustersY = 0;
+  std::vector<Cluster> clusters;
+  std::vector<Node> nodes;
+  std::vector<int> freeNodes;
+  std::vector<std::vector<int>> borderNodes;
+
+  std::uint32_t gridVersion = 0;
+  std::uint32_t buildVersion = 0;
+  std::size_t editsSeen = 0; // Grid edits already applied
+
+  // Scratch reused by every query and rebuild
+  std::vector<int> clusterDistance; // Distances from one cell in a cluster
+  std::vector<int> frontier;
+  std::vector<Edge> startEdges;
+  std::vector<Edge> goalEdges;
+  std::vector<SearchNode> search;
+  std::vector<OpenEntry> open;
+  std::vector<int> routeNodes;
+  std::uint32_t generation = 0;
+
+  std::size_t lastRebuilt = 0;
+  std::size_t lastExpanded = 0;
+};
+
+} // namespace Navigation
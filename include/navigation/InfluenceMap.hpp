@@ -0,0 +1,74 @@
+#pragma once
+
+#include "core/services/JobSystem.hpp"
+#include "navigation/NavGrid.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace Navigation {
+
+// How much of something is around each part of the map, on a coarse grid of
+// CELL_SIZE x CELL_SIZE tiles over the NavGrid's extent. Every update decays
+// the old values, adds one unit per mob or player to the cell it stands in,
+// and spreads the result to neighbouring cells with a separable [1 2 1] / 4
+// blur. Influence thus fades with distance and time, and one lookup answers
+// "how crowded is it here" without a mob looking at every other mob.
+//
+// The blur doesn't know about walls; at this resolution influence leaking
+// through a wall is the price of a flat, cheap pass.
+class InfluenceMap {
+public:
+  enum Layer : std::size_t {
+    Crowd, // Mobs (MobTag)
+    Player,
+    LAYER_COUNT
+  };
+
+  static constexpr int CELL_SIZE = 4;  // Tiles per side of a cell
+  static constexpr float DECAY = 0.9f; // Share kept from one update to the next
+
+  void update(const entt::registry &registry, const NavGrid &grid,
+              Core::Services::JobSystem &jobs);
+  void clear();
+
+  // Influence at a tile; zero outside the map
+  float sample(Layer layer, int x, int y) const {
+    if (x < originX || y < originY) {
+      return 0.0f;
+    }
+    const int cellX = (x - originX) / CELL_SIZE;
+    const int cellY = (y - originY) / CELL_SIZE;
+    if (cellX >= width || cellY >= height) {
+      return 0.0f;
+    }
+    return layers[layer][cellY * width + cellX];
+  }
+
+  // Coarse cells, row by row
+  const std::vector<float> &getValues(Layer layer) const {
+    return layers[layer];
+  }
+  int getOriginX() const { return originX; } // Tile at the corner of cell 0
+  int getOriginY() const { return originY; }
+  int getWidth() const { return width; } // In cells
+  int getHeight() const { return height; }
+
+private:
+  void resize(const NavGrid &grid);
+  void splat(Layer layer, int x, int y);
+  void blur(std::vector<float> &values, Core::Services::JobSystem &jobs);
+
+  int originX = 0;
+  int originY = 0;
+  int width = 0;
+  int height = 0;
+  std::array<std::vector<float>, LAYER_COUNT> layers;
+  std::vector<float> scratch; // Horizontal pass output
+  const NavGrid *mapGrid = nullptr;
+  std::uint32_t gridBuild = 0;
+};
+
+} // namespace Navigation
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace Navigation {
+
+// Walkable cells of the current map in tile coordinates, packed into a dense
+// array over the map's bounding box. Built from FloorTag entities minus cells
+// holding a static blocking collider (TileColliderTag). Mobs and the player
+// move, so they don't make a cell unwalkable; movement checks them instead.
+class NavGrid {
+public:
+  // Rebuilding to the same extent only touches the cells that changed
+  void build(const entt::registry &registry);
+  void clear();
+  // Change one cell in place, e.g. when a wall is dug out
+  void setWalkable(int x, int y, bool value);
+
+  bool contains(int x, int y) const {
+    return x >= originX && y >= originY && x < originX + width &&
+           y < originY + height;
+  }
+  bool isWalkable(int x, int y) const {
+    return contains(x, y) && walkable[toIndex(x, y)];
+  }
+  bool isWalkable(int index) const { return walkable[index]; }
+
+  // Cell index for a contained position, and back
+  int toIndex(int x, int y) const {
+    return (y - originY) * width + x - originX;
+  }
+  int indexX(int index) const { return originX + index % width; }
+  int indexY(int index) const { return originY + index / width; }
+
+  int getOriginX() const { return originX; }
+  int getOriginY() const { return originY; }
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+  std::size_t getCellCount() const { return walkable.size(); }
+
+  // Changes whenever the grid is rebuilt or edited, so users can tell stale
+  // data
+  std::uint32_t getVersion() const { return version; }
+  // Changes only when the grid's extent does. Until then getEdits() lists the
+  // cells changed by setWalkable or by rebuilding, oldest first, so users
+  // can catch up on just those.
+  std::uint32_t getBuildVersion() const { return buildVersion; }
+  const std::vector<int> &getEdits() const { return edits; }
+
+private:
+  int originX = 0;
+  int originY = 0;
+  int width = 0;
+  int height = 0;
+  std::vector<std::uint8_t> walkable;
+  std::vector<int> edits;
+  std::uint32_t version = 0;
+  std::uint32_t buildVersion = 0;
+};
+
+} // namespace Navigation
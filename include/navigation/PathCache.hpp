@@ -0,0 +1,76 @@
+#pragma once
+
+#include "core/Components.h"
+#include "navigation/NavGrid.hpp"
+#include "navigation/Pathfinding.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace Navigation {
+
+// Bounded LRU cache of routes on top of Pathfinding. Mobs leaving the same
+// room for the same target ask for nearly the same route, so entries are
+// keyed by the REGION_SIZE square region a route starts in and its goal
+// cell. A request from another cell of the region reuses the cached route:
+// it only searches from its start to the last cell where the route is still
+// in the region, and splices on the rest. Spliced routes are near-shortest
+// rather than shortest.
+//
+// Entries follow the grid's edits, from setWalkable or a hot reload through
+// NavGrid::build: a cell closing drops the routes crossing it, and a cell
+// opening drops the routes whose bounds hold it, since it may shorten them.
+// A new grid extent drops every entry.
+class PathCache {
+public:
+  static constexpr int REGION_SIZE = 8;
+
+  PathCache(const NavGrid &grid, Pathfinding &pathfinding,
+            std::size_t capacity = 256)
+      : grid(grid), pathfinding(pathfinding), capacity(capacity) {}
+
+  // Like Pathfinding::findPath, from the cache when it can be
+  bool findPath(int startX, int startY, int goalX, int goalY,
+                Components::PathComponent &path,
+                Pathfinding::Solver solver = Pathfinding::Solver::JumpPoint);
+
+  void clear();
+
+  std::size_t getSize() const { return lookup.size(); }
+  std::size_t getCapacity() const { return capacity; }
+  std::size_t getHits() const { return hits; }
+  std::size_t getMisses() const { return misses; }
+
+private:
+  using Step = Components::PathComponent::Step;
+
+  struct Entry {
+    std::uint64_t key;
+    int startX, startY;
+    std::vector<Step> steps;
+    int minX, minY, maxX, maxY; // Bounds of the route, start included
+  };
+
+  // Drop the entries the grid's changes since the last call affect
+  void sync();
+  void store(std::uint64_t key, int startX, int startY,
+             const std::vector<Step> &steps);
+  bool inRegion(int region, int x, int y) const;
+
+  const NavGrid &grid;
+  Pathfinding &pathfinding;
+  std::size_t capacity;
+
+  std::list<Entry> entries; // Most recently used first
+  std::unordered_map<std::uint64_t, std::list<Entry>::iterator> lookup;
+
+  std::uint32_t gridVersion = 0;
+  std::uint32_t buildVersion = 0;
+  std::size_t editsSeen = 0;
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+};
+
+} // namespace Navigation
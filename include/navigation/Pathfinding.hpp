@@ -0,0 +1,66 @@
+#pragma once
+
+#include "core/Components.h"
+#include "navigation/NavGrid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Navigation {
+
+// 4-connected A* over a NavGrid. The per-cell search state lives in arrays
+// sized to the grid and reused by every query: a cell's entry only counts if
+// its generation matches the running query, so starting a query is O(1)
+// rather than a clear. The open set is a binary heap in a vector that keeps
+// its capacity, so steady-state queries don't allocate.
+//
+// The scratch state makes an instance single-threaded; give each thread
+// that plans paths its own.
+class Pathfinding {
+public:
+  // How a query searches; both return a shortest path
+  enum class Solver {
+    AStar,    // Expands every cell it reaches
+    JumpPoint // Jumps along straight runs, expanding only where paths turn
+  };
+
+  explicit Pathfinding(const NavGrid &grid) : grid(grid) {}
+
+  // Shortest path from start to goal. On success path.steps holds the cells
+  // after start up to and including goal, and path.next is reset. Jump point
+  // search pays off on long paths through corridors and open rooms; plain
+  // A* is cheaper for short hops.
+  bool findPath(int startX, int startY, int goalX, int goalY,
+                Components::PathComponent &path,
+                Solver solver = Solver::AStar);
+
+  // Cells expanded by the last query
+  std::size_t getLastExpanded() const { return lastExpanded; }
+
+private:
+  struct Node {
+    std::uint32_t generation = 0; // Query that last touched this cell
+    bool closed = false;
+    int cost = 0;    // Steps from the start
+    int parent = -1; // Cell the best path arrived from, maybe several away
+  };
+
+  struct OpenEntry {
+    int estimate; // Cost so far plus the heuristic
+    int cost;
+    int index;
+  };
+
+  void beginQuery();
+  // Follow a direction from (x, y) to the next jump point; -1 if none
+  int jump(int x, int y, int dx, int dy, int goal) const;
+
+  const NavGrid &grid;
+  std::vector<Node> nodes;
+  std::vector<OpenEntry> open;
+  std::uint32_t generation = 0;
+  std::uint32_t gridVersion = 0;
+  std::size_t lastExpanded = 0;
+};
+
+} // namespace Navigation
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <string>
+#include <vector>
+
+namespace Rendering {
+
+// A sprite to draw, in tile coordinates
+struct SpriteInstance {
+  int x;
+  int y;
+  int tileId;
+  std::uint16_t tileset; // Index into RenderSnapshot::tilesets
+};
+
+// What the renderer needs from one simulation tick, copied out of the
+// registry so it can be drawn while the simulation moves on. Capturing into
+// an old snapshot reuses its storage.
+struct RenderSnapshot {
+  int tick = 0;
+  bool hasFocus = false; // Whether there is a player to center the camera on
+  int focusX = 0;
+  int focusY = 0;
+  std::vector<std::string> tilesets;
+  std::vector<SpriteInstance> sprites; // Floors, then walls, then entities
+  // Only capture sprites in the player's field of view, when it has one
+  bool fogOfWar = true;
+
+  void capture(const entt::registry &registry, int currentTick);
+
+private:
+  std::uint16_t tilesetIndex(const std::string &name);
+};
+
+} // namespace Rendering
@@ -2,8 +2,11 @@
 
 #include "../core/Components.h"
 #include "../core/GameManager.h"
+#include "RenderSnapshot.hpp"
 #include <SDL2/SDL.h>
 #include <entt/entt.hpp>
+#include <string>
+#include <vector>
 
 namespace Rendering
 {
@@ -14,19 +17,26 @@ namespace Rendering
         Renderer(GameManager *gameManager);
         ~Renderer() = default;
 
-        void render(entt::registry &registry);
+        // Draws a snapshot; never touches the live registry, so it can run
+        // while the simulation thread ticks
+        void render(const RenderSnapshot &snapshot);
         void setViewport(const SDL_Rect &viewport) { m_viewport = viewport; }
         void setCameraScale(float scale) { m_cameraScale = scale; }
         float getCameraScale() const { return m_cameraScale; }
 
       private:
-        void renderGameEntities(entt::registry &registry, int offsetX, int offsetY);
-        void calculateCameraOffset(entt::registry &registry, int &offsetX, int &offsetY);
+        void renderGameEntities(const RenderSnapshot &snapshot, int offsetX, int offsetY);
+        void calculateCameraOffset(const RenderSnapshot &snapshot, int &offsetX, int &offsetY);
+        int getTilesPerRow(const std::string &tilesetName) const;
 
         GameManager *m_gameManager;
         SDL_Rect m_viewport{0, 0, 1024, 768};
         float m_cameraScale{4.0f}; // Scale up 8x8 tiles by 4x to make them 32x32
 
+        // Per-tileset lookups for the snapshot being drawn
+        std::vector<SDL_Texture *> m_tilesetTextures;
+        std::vector<int> m_tilesetColumns;
+
         // Gameplay area dimensions (30x20 tiles at 32x32 pixels each)
         static constexpr int GAMEPLAY_WIDTH = 30 * 32;  // 960 pixels
         static constexpr int GAMEPLAY_HEIGHT = 20 * 32; // 640 pixels
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Rendering {
+
+// Lock-free single-producer/single-consumer triple buffer. The producer
+// fills the back buffer and publishes it; the consumer picks up the newest
+// published buffer whenever it likes. Neither side ever waits: the producer
+// always has a free buffer to write and the consumer keeps drawing its
+// current buffer until a newer one is available. Intermediate publishes the
+// consumer never saw are simply overwritten.
+template <typename T> class TripleBuffer {
+public:
+  // Producer: the buffer to fill next. Its previous contents are a stale
+  // snapshot, so a producer can reuse their capacity.
+  T &writeBuffer() { return buffers[back]; }
+
+  // Producer: hand the filled buffer to the consumer
+  void publish() {
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+  }
+
+  // Consumer: switch to the newest published buffer. Returns false, keeping
+  // the current buffer, when nothing was published since the last call.
+  bool acquire() {
+    if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+      return false;
+    }
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+    return true;
+  }
+
+  // Consumer: the buffer picked up by the last acquire()
+  const T &readBuffer() const { return buffers[front]; }
+
+private:
+  static constexpr std::uint8_t INDEX = 0x3;
+  static constexpr std::uint8_t FRESH = 0x4;
+
+  T buffers[3]{};
+  std::uint8_t back = 0;  // Owned by the producer
+  std::uint8_t front = 2; // Owned by the consumer
+  std::atomic<std::uint8_t> middle{1};
+};
+
+} // namespace Rendering
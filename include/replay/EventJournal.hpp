@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace Replay {
+
+// What a journal record holds. Records are written in tick order: a
+// TickBegin, the input commands applied that tick, then the events the
+// EventBus delivered. ScenarioReset records sit between ticks.
+enum class RecordKind : std::uint8_t {
+  TickBegin,
+  ScenarioReset,
+  InputCommand,
+  Event
+};
+
+// Payload of a TickBegin record
+struct TickRecord {
+  std::uint32_t seed;   // Passed to srand() before the tick runs
+  std::uint32_t timeMs; // Game time derived from the tick count
+};
+
+// Payload of a ScenarioReset record
+struct ScenarioRecord {
+  std::uint32_t seed;
+  std::int32_t usingDungeonGenerator;
+  std::int32_t totalFloorCount;
+  std::int32_t minHall;
+  std::int32_t maxHall;
+  std::int32_t roomDim;
+  std::int32_t tileWidth;
+  std::int32_t tileHeight;
+};
+
+// A record as seen by JournalReader. The payload points into the mapping.
+struct Record {
+  std::uint32_t tick = 0;
+  RecordKind kind = RecordKind::TickBegin;
+  std::uint8_t tag = 0; // GameEventType for Event records
+  std::span<const std::byte> payload;
+
+  template <typename T> T as() const {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    std::memcpy(&value, payload.data(), std::min(sizeof(T), payload.size()));
+    return value;
+  }
+};
+
+// Appends records to a memory-mapped file. The file grows in large chunks
+// and is truncated to its real size on close, so writing a record is a
+// bounds check and a memcpy.
+class JournalWriter {
+public:
+  JournalWriter() = default;
+  ~JournalWriter();
+
+  JournalWriter(const JournalWriter &) = delete;
+  JournalWriter &operator=(const JournalWriter &) = delete;
+
+  bool open(const std::string &path);
+  void close();
+  bool isOpen() const { return fd >= 0; }
+
+  template <typename T>
+  void write(std::uint32_t tick, RecordKind kind, const T &payload,
+             std::uint8_t tag = 0) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Journal payloads must be trivially copyable");
+    writeRecord(tick, kind, tag, &payload, sizeof(T));
+  }
+
+  void writeRecord(std::uint32_t tick, RecordKind kind, std::uint8_t tag,
+                   const void *data, std::size_t size);
+
+  std::size_t bytesWritten() const { return used; }
+
+private:
+  bool grow(std::size_t needed);
+
+  int fd = -1;
+  std::byte *mapped = nullptr;
+  std::size_t capacity = 0;
+  std::size_t used = 0;
+  std::string path;
+};
+
+// Reads a journal back through a read-only mapping of the whole file
+class JournalReader {
+public:
+  JournalReader() = default;
+  ~JournalReader();
+
+  JournalReader(const JournalReader &) = delete;
+  JournalReader &operator=(const JournalReader &) = delete;
+
+  bool open(const std::string &path);
+  void close();
+  bool isOpen() const { return mapped != nullptr; }
+
+  // Read the next record; false at the end of the journal or on corruption
+  bool next(Record &record);
+
+  std::size_t size() const { return length; }
+
+private:
+  const std::byte *mapped = nullptr;
+  std::size_t length = 0;
+  std::size_t offset = 0;
+};
+
+} // namespace Replay
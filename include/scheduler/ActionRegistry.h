@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <entt/entt.hpp>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+// Stable identifier of a named action type, e.g. entt::hashed_string{"damage"}
+using ActionTypeID = entt::id_type;
+
+// Fixed-size argument block carried by a typed action. Arguments must be
+// trivially copyable so they can be written to a save blob byte for byte.
+struct ActionArgs {
+  static constexpr std::size_t CAPACITY = 32;
+
+  std::array<std::byte, CAPACITY> data{};
+  std::uint8_t size = 0;
+
+  template <typename T> static ActionArgs pack(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Action arguments must be trivially copyable");
+    static_assert(sizeof(T) <= CAPACITY, "Action arguments are too large");
+
+    ActionArgs args;
+    std::memcpy(args.data.data(), &value, sizeof(T));
+    args.size = static_cast<std::uint8_t>(sizeof(T));
+    return args;
+  }
+
+  template <typename T> T unpack() const {
+    T value{};
+    std::memcpy(&value, data.data(), sizeof(T));
+    return value;
+  }
+};
+
+// Named, parameterized action types. Actions scheduled through a registered
+// type are plain (type ID, args) data rather than opaque closures, which is
+// what lets Scheduler::serialize checkpoint them and Scheduler::restore
+// rebuild them. Every type used by a save must be defined again before the
+// save is restored. The registry must outlive any Scheduler holding its
+// actions, since bound actions and their labels point into it.
+class ActionRegistry {
+public:
+  using Invoker =
+      std::function<void(entt::entity, entt::registry &, const ActionArgs &)>;
+
+  // Define an action type taking Args; returns false if the name is taken
+  template <typename Args>
+  bool define(entt::hashed_string name,
+              void (*fn)(entt::entity, entt::registry &, const Args &)) {
+    static_assert(std::is_trivially_copyable_v<Args>,
+                  "Action arguments must be trivially copyable");
+    static_assert(sizeof(Args) <= ActionArgs::CAPACITY,
+                  "Action arguments are too large");
+
+    auto [it, inserted] = types.try_emplace(name.value());
+    if (!inserted) {
+      std::cerr << "Action type already defined: " << name.data()
+                << std::endl;
+      return false;
+    }
+
+    it->second.name = name.data();
+    it->second.argsSize = sizeof(Args);
+    it->second.invoke = [fn](entt::entity entity, entt::registry &registry,
+                             const ActionArgs &args) {
+      fn(entity, registry, args.unpack<Args>());
+    };
+    return true;
+  }
+
+  bool contains(ActionTypeID type) const { return types.count(type) > 0; }
+
+  // Name of a type, also used as its metrics label; nullptr if unknown
+  const char *getName(ActionTypeID type) const {
+    auto it = types.find(type);
+    return it == types.end() ? nullptr : it->second.name.c_str();
+  }
+
+  // Expected argument size of a type, used to validate restored entries
+  std::size_t getArgsSize(ActionTypeID type) const {
+    auto it = types.find(type);
+    return it == types.end() ? 0 : it->second.argsSize;
+  }
+
+  // Build the callable for a typed action; empty if the type is unknown
+  std::function<void(entt::entity, entt::registry &)>
+  bind(ActionTypeID type, const ActionArgs &args) const {
+    auto it = types.find(type);
+    if (it == types.end()) {
+      return nullptr;
+    }
+
+    return [invoke = &it->second.invoke, args](entt::entity entity,
+                                               entt::registry &registry) {
+      (*invoke)(entity, registry, args);
+    };
+  }
+
+private:
+  struct ActionType {
+    std::string name;
+    std::size_t argsSize = 0;
+    Invoker invoke;
+  };
+
+  std::unordered_map<ActionTypeID, ActionType> types;
+};
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Pooled storage for coroutine frames. Frames are rounded up to 64-byte size
+// classes and recycled through per-class free lists, so spawning scripted
+// sequences stops touching the global heap once the pool has warmed up.
+// Like the Scheduler itself, the pool is meant to be used from one thread.
+class TaskFramePool {
+public:
+  static void *allocate(std::size_t size) {
+    std::size_t sizeClass = classFor(size);
+    if (sizeClass >= CLASS_COUNT) {
+      return ::operator new(size);
+    }
+
+    auto &pool = instance();
+    FreeNode *node = pool.freeLists[sizeClass];
+    if (!node) {
+      node = pool.refill(sizeClass);
+    }
+    pool.freeLists[sizeClass] = node->next;
+    return node;
+  }
+
+  static void deallocate(void *ptr, std::size_t size) {
+    std::size_t sizeClass = classFor(size);
+    if (sizeClass >= CLASS_COUNT) {
+      ::operator delete(ptr);
+      return;
+    }
+
+    auto &pool = instance();
+    auto *node = static_cast<FreeNode *>(ptr);
+    node->next = pool.freeLists[sizeClass];
+    pool.freeLists[sizeClass] = node;
+  }
+
+private:
+  static constexpr std::size_t CLASS_GRANULARITY = 64;
+  static constexpr std::size_t CLASS_COUNT = 16; // Frames up to 1 KiB
+  static constexpr std::size_t FRAMES_PER_BLOCK = 64;
+
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  static std::size_t classFor(std::size_t size) {
+    return size == 0 ? 0 : (size - 1) / CLASS_GRANULARITY;
+  }
+
+  static TaskFramePool &instance() {
+    static TaskFramePool pool;
+    return pool;
+  }
+
+  // Carve a fresh block into frames of the given class and thread them onto
+  // the free list
+  FreeNode *refill(std::size_t sizeClass) {
+    std::size_t frameSize = (sizeClass + 1) * CLASS_GRANULARITY;
+    auto block = std::make_unique<std::byte[]>(frameSize * FRAMES_PER_BLOCK);
+
+    FreeNode *head = nullptr;
+    for (std::size_t i = FRAMES_PER_BLOCK; i-- > 0;) {
+      auto *node = reinterpret_cast<FreeNode *>(block.get() + i * frameSize);
+      node->next = head;
+      head = node;
+    }
+
+    blocks.push_back(std::move(block));
+    return head;
+  }
+
+  std::array<FreeNode *, CLASS_COUNT> freeLists{};
+  std::vector<std::unique_ptr<std::byte[]>> blocks;
+};
+
+class TaskQueue;
+
+// Awaitable returned by Scheduler::wait / TaskQueue::wait
+struct TickAwaiter {
+  TaskQueue *queue;
+  int ticks;
+
+  bool await_ready() const noexcept { return ticks <= 0; }
+  void await_suspend(std::coroutine_handle<> handle) const;
+  void await_resume() const noexcept {}
+};
+
+// Tag awaited as `co_await nextTick` to yield until the following tick
+struct NextTick {};
+inline constexpr NextTick nextTick{};
+
+// Coroutine type for multi-step scripted behaviour driven by the Scheduler.
+// A task is inert until handed to Scheduler::spawn, which runs it up to its
+// first co_await. The frame frees itself when the coroutine returns.
+class ScheduledTask {
+public:
+  struct promise_type {
+    TaskQueue *queue = nullptr;
+
+    ScheduledTask get_return_object() {
+      return ScheduledTask(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { throw; }
+
+    TickAwaiter await_transform(NextTick) { return TickAwaiter{queue, 1}; }
+    TickAwaiter await_transform(TickAwaiter awaiter) { return awaiter; }
+
+    static void *operator new(std::size_t size) {
+      return TaskFramePool::allocate(size);
+    }
+    static void operator delete(void *ptr, std::size_t size) {
+      TaskFramePool::deallocate(ptr, size);
+    }
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  ScheduledTask(ScheduledTask &&other) noexcept
+      : handle(std::exchange(other.handle, nullptr)) {}
+  ScheduledTask &operator=(ScheduledTask &&other) noexcept {
+    if (this != &other) {
+      reset();
+      handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+  }
+  ScheduledTask(const ScheduledTask &) = delete;
+  ScheduledTask &operator=(const ScheduledTask &) = delete;
+
+  ~ScheduledTask() { reset(); }
+
+  // Give up ownership of the frame (used by TaskQueue::spawn)
+  Handle release() { return std::exchange(handle, nullptr); }
+
+private:
+  explicit ScheduledTask(Handle handle) : handle(handle) {}
+
+  void reset() {
+    if (handle) {
+      handle.destroy();
+      handle = nullptr;
+    }
+  }
+
+  Handle handle;
+};
+
+// Suspended tasks ordered by wake-up tick. Owned by the Scheduler, which
+// resumes due tasks directly from update() without going through the action
+// queue or allocating closures.
+class TaskQueue {
+public:
+  TaskQueue() = default;
+  TaskQueue(const TaskQueue &) = delete;
+  TaskQueue &operator=(const TaskQueue &) = delete;
+  ~TaskQueue() { clear(); }
+
+  // Start a task; it runs synchronously until its first suspension
+  void spawn(ScheduledTask task) {
+    ScheduledTask::Handle handle = task.release();
+    if (!handle) {
+      return;
+    }
+    handle.promise().queue = this;
+    resume(handle);
+  }
+
+  TickAwaiter wait(int ticks) { return TickAwaiter{this, ticks}; }
+
+  // Resume every task whose wake-up tick has been reached. Tasks that suspend
+  // again during this call are queued for a later tick.
+  void resumeDue(int tick) {
+    currentTick = tick;
+    while (!sleeping.empty() && sleeping.front().wakeTick <= currentTick) {
+      std::pop_heap(sleeping.begin(), sleeping.end(), later);
+      std::coroutine_handle<> handle = sleeping.back().handle;
+      sleeping.pop_back();
+      resume(handle);
+    }
+  }
+
+  // Destroy all suspended frames
+  void clear() {
+    for (auto &entry : sleeping) {
+      entry.handle.destroy();
+    }
+    sleeping.clear();
+  }
+
+  std::size_t size() const { return sleeping.size(); }
+  int getCurrentTick() const { return currentTick; }
+
+private:
+  friend struct TickAwaiter;
+
+  struct Sleeper {
+    int wakeTick;
+    std::uint64_t sequence; // Keeps same-tick wake-ups in FIFO order
+    std::coroutine_handle<> handle;
+  };
+
+  static bool later(const Sleeper &a, const Sleeper &b) {
+    if (a.wakeTick == b.wakeTick) {
+      return a.sequence > b.sequence;
+    }
+    return a.wakeTick > b.wakeTick;
+  }
+
+  void suspend(int ticks, std::coroutine_handle<> handle) {
+    sleeping.push_back(Sleeper{currentTick + ticks, nextSequence++, handle});
+    std::push_heap(sleeping.begin(), sleeping.end(), later);
+  }
+
+  // A task that throws is left at its final suspend point; free its frame
+  // before letting the exception reach the caller
+  static void resume(std::coroutine_handle<> handle) {
+    try {
+      handle.resume();
+    } catch (...) {
+      handle.destroy();
+      throw;
+    }
+  }
+
+  std::vector<Sleeper> sleeping;
+  std::uint64_t nextSequence = 0;
+  int currentTick = 0;
+};
+
+inline void TickAwaiter::await_suspend(std::coroutine_handle<> handle) const {
+  queue->suspend(ticks, handle);
+}
@@ -1,10 +1,19 @@
 #pragma once
 
 #include "../events/GameEvents.h"
+#include "ActionRegistry.h"
+#include "ScheduledTask.h"
+#include "SchedulerMetrics.h"
+#include "TickBudget.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <entt/entt.hpp>
 #include <functional>
-#include <queue>
+#include <iostream>
+#include <span>
 #include <unordered_set>
+#include <vector>
 
 using ActionID = uint32_t;
 
@@ -16,12 +25,35 @@ struct ScheduledAction {
   std::function<void(ActionID, entt::entity, entt::registry &,
                      entt::dispatcher &)>
       onComplete;
+  const char *label = nullptr; // Tag used by SchedulerMetrics
+  int priority = 0; // Higher priority actions execute first within a tick
+  ActionTypeID type = 0; // Set for ActionRegistry actions, which serialize
+  ActionArgs args{};
 
   bool operator<(const ScheduledAction &other) const {
+    if (tick == other.tick) {
+      if (priority == other.priority) {
+        // Older actions first, so a restored queue replays in the same order
+        return id > other.id;
+      }
+      return priority < other.priority; // Higher priority first
+    }
     return tick > other.tick; // Min-heap behavior for priority queue
   }
 };
 
+// Contiguous block of IDs assigned by Scheduler::scheduleBatch
+struct ActionIDRange {
+  ActionID first = 0;
+  ActionID count = 0;
+
+  bool contains(ActionID id) const { return id >= first && id - first < count; }
+  ActionID operator[](std::size_t index) const {
+    return first + static_cast<ActionID>(index);
+  }
+  std::size_t size() const { return count; }
+};
+
 class Scheduler {
 public:
   Scheduler() : nextActionId(1) {}
@@ -31,7 +63,8 @@ public:
     ActionID actionId = nextActionId++;
     ScheduledAction actionWithId = action;
     actionWithId.id = actionId;
-    queue.push(actionWithId);
+    queue.push_back(std::move(actionWithId));
+    std::push_heap(queue.begin(), queue.end());
     activeActions.insert(actionId);
     return actionId;
   }
@@ -41,29 +74,286 @@ public:
                     std::function<void(entt::entity, entt::registry &)> action,
                     std::function<void(ActionID, entt::entity, entt::registry &,
                                        entt::dispatcher &)>
-                        onComplete = nullptr) {
+                        onComplete = nullptr,
+                    const char *label = nullptr, int priority = 0) {
     ScheduledAction scheduledAction{0, tick, entity, std::move(action),
-                                    std::move(onComplete)};
+                                    std::move(onComplete), label, priority};
     return schedule(scheduledAction);
   }
 
+  // Build an action of a registered type. The label is the type name. The
+  // type must be registered: an unknown one binds to an empty function,
+  // which would throw when the action runs.
+  static ScheduledAction makeAction(const ActionRegistry &types, int tick,
+                                    entt::entity entity, ActionTypeID type,
+                                    const ActionArgs &args, int priority = 0) {
+    assert(types.contains(type));
+    ScheduledAction action{0, tick, entity, types.bind(type, args), nullptr,
+                           types.getName(type), priority};
+    action.type = type;
+    action.args = args;
+    return action;
+  }
+
+  // Schedule an action of a registered type. Unlike closures these are kept
+  // by serialize(). Returns 0 if the type is unknown.
+  template <typename Args>
+  ActionID schedule(const ActionRegistry &types, int tick, entt::entity entity,
+                    ActionTypeID type, const Args &args, int priority = 0) {
+    if (!types.contains(type)) {
+      std::cerr << "Unknown action type: " << type << std::endl;
+      return 0;
+    }
+    return schedule(makeAction(types, tick, entity, type,
+                               ActionArgs::pack(args), priority));
+  }
+
+  // Schedule many actions at once (e.g. a wave spawn). Storage is reserved
+  // once, the entries are moved out of the span and the heap is rebuilt in a
+  // single linear pass instead of sifting each entry in. IDs are assigned in
+  // span order and returned as one range.
+  ActionIDRange scheduleBatch(std::span<ScheduledAction> actions) {
+    ActionIDRange range{nextActionId, static_cast<ActionID>(actions.size())};
+    if (actions.empty()) {
+      return range;
+    }
+
+    const std::size_t heapSize = queue.size();
+    queue.reserve(heapSize + actions.size());
+    activeActions.reserve(activeActions.size() + actions.size());
+
+    for (auto &action : actions) {
+      action.id = nextActionId++;
+      activeActions.insert(action.id);
+      queue.push_back(std::move(action));
+    }
+
+    // A small batch on top of a large heap is cheaper to sift in; otherwise
+    // make_heap over everything is linear
+    if (actions.size() * 8 < heapSize) {
+      for (auto it = queue.begin() + heapSize; it != queue.end(); ++it) {
+        std::push_heap(queue.begin(), it + 1);
+      }
+    } else {
+      std::make_heap(queue.begin(), queue.end());
+    }
+
+    return range;
+  }
+
   // Cancel a scheduled action
   bool cancel(ActionID id) {
     if (activeActions.find(id) != activeActions.end()) {
-      // We can't remove from the priority queue directly, so we mark it as
-      // inactive
+      // We can't remove from the heap directly, so we mark it as inactive
       activeActions.erase(id);
       return true;
     }
     return false;
   }
 
+  // Cancel every action of a batch; returns how many were still pending
+  std::size_t cancel(ActionIDRange range) {
+    std::size_t cancelled = 0;
+    for (std::size_t i = 0; i < range.size(); ++i) {
+      cancelled += activeActions.erase(range[i]);
+    }
+    return cancelled;
+  }
+
+  // Start a coroutine task. It runs until its first co_await and is then
+  // resumed by update() once the awaited number of ticks has elapsed.
+  void spawn(ScheduledTask task) { tasks.spawn(std::move(task)); }
+
+  // Awaitable for use inside a task: `co_await scheduler.wait(ticks)`
+  TickAwaiter wait(int ticks) { return tasks.wait(ticks); }
+
   // Process actions that are due at the current tick
   void update(int current_tick, entt::registry &registry,
               entt::dispatcher &dispatcher) {
-    while (!queue.empty() && queue.top().tick <= current_tick) {
-      ScheduledAction action = queue.top();
-      queue.pop();
+    drain(current_tick, registry, dispatcher, nullptr);
+  }
+
+  // Process due actions until the budget runs out. Actions run in
+  // (tick, priority) order, so the ones left behind are the lowest-priority
+  // work of the newest tick; they stay queued and run first next update.
+  // Coroutine tasks are always resumed and are not counted against the budget.
+  TickBudgetReport update(int current_tick, entt::registry &registry,
+                          entt::dispatcher &dispatcher,
+                          std::chrono::microseconds budget) {
+    TickBudget tickBudget(budget);
+    return drain(current_tick, registry, dispatcher, &tickBudget);
+  }
+
+  // Attach an instrumentation sink (no-op unless SCHEDULER_METRICS is set)
+  void setMetrics([[maybe_unused]] SchedulerMetrics *sink) {
+#ifdef SCHEDULER_METRICS
+    metrics = sink;
+#endif
+  }
+
+  std::size_t pendingCount() const { return activeActions.size(); }
+
+  // Write the pending action queue to a compact binary blob. Only registry
+  // actions can be saved; if a live closure action or an onComplete callback
+  // is pending this fails rather than silently dropping it. Coroutine tasks
+  // are not part of the blob. Entities are stored as raw identifiers, so the
+  // registry must be restored with the same entity IDs (as entt snapshots
+  // do). The blob uses host byte order.
+  bool serialize(std::vector<std::byte> &out) const {
+    std::vector<const ScheduledAction *> live;
+    live.reserve(activeActions.size());
+    for (const auto &action : queue) {
+      if (activeActions.count(action.id) == 0) {
+        continue;
+      }
+      if (action.type == 0 || action.onComplete) {
+        std::cerr << "Cannot serialize action " << action.id << " ("
+                  << (action.label ? action.label : "unlabeled")
+                  << "): not a registered action type" << std::endl;
+        return false;
+      }
+      live.push_back(&action);
+    }
+
+    out.clear();
+    out.reserve(HEADER_SIZE + live.size() * MAX_ENTRY_SIZE);
+    writeValue(out, SAVE_MAGIC);
+    writeValue(out, SAVE_VERSION);
+    writeValue(out, nextActionId);
+    writeValue(out, static_cast<std::uint32_t>(live.size()));
+
+    for (const ScheduledAction *action : live) {
+      writeValue(out, action->id);
+      writeValue(out, action->tick);
+      writeValue(out, entt::to_integral(action->entity));
+      writeValue(out, action->type);
+      writeValue(out, action->priority);
+      writeValue(out, action->args.size);
+      const auto *bytes = action->args.data.data();
+      out.insert(out.end(), bytes, bytes + action->args.size);
+    }
+
+    return true;
+  }
+
+  // Replace the pending action queue with one read from serialize(). Every
+  // action type in the blob must be defined in `types`. On error nothing is
+  // changed. Running coroutine tasks are left alone.
+  bool restore(std::span<const std::byte> blob, const ActionRegistry &types) {
+    std::size_t offset = 0;
+    std::uint32_t magic = 0;
+    std::uint16_t version = 0;
+    ActionID savedNextId = 0;
+    std::uint32_t count = 0;
+
+    if (!readValue(blob, offset, magic) || magic != SAVE_MAGIC ||
+        !readValue(blob, offset, version) || version != SAVE_VERSION ||
+        !readValue(blob, offset, savedNextId) ||
+        !readValue(blob, offset, count)) {
+      std::cerr << "Invalid scheduler save header" << std::endl;
+      return false;
+    }
+
+    std::vector<ScheduledAction> restored;
+    restored.reserve(count);
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+      ActionID id = 0;
+      int tick = 0;
+      entt::id_type entity = 0;
+      ActionTypeID type = 0;
+      int priority = 0;
+      ActionArgs args;
+
+      if (!readValue(blob, offset, id) || !readValue(blob, offset, tick) ||
+          !readValue(blob, offset, entity) || !readValue(blob, offset, type) ||
+          !readValue(blob, offset, priority) ||
+          !readValue(blob, offset, args.size) ||
+          args.size > ActionArgs::CAPACITY ||
+          blob.size() - offset < args.size) {
+        std::cerr << "Truncated scheduler save at entry " << i << std::endl;
+        return false;
+      }
+      std::memcpy(args.data.data(), blob.data() + offset, args.size);
+      offset += args.size;
+
+      if (!types.contains(type) || types.getArgsSize(type) != args.size) {
+        std::cerr << "Scheduler save references unknown action type " << type
+                  << std::endl;
+        return false;
+      }
+
+      ScheduledAction action = makeAction(
+          types, tick, entt::entity{entity}, type, args, priority);
+      action.id = id;
+      restored.push_back(std::move(action));
+    }
+
+    queue = std::move(restored);
+    std::make_heap(queue.begin(), queue.end());
+    activeActions.clear();
+    for (const auto &action : queue) {
+      activeActions.insert(action.id);
+    }
+    nextActionId = savedNextId;
+    return true;
+  }
+
+  // Clear all pending actions
+  void clear() {
+    queue.clear();
+    activeActions.clear();
+    tasks.clear();
+  }
+
+private:
+  static constexpr std::uint32_t SAVE_MAGIC = 0x44484353; // "SCHD"
+  static constexpr std::uint16_t SAVE_VERSION = 1;
+  static constexpr std::size_t HEADER_SIZE = 14;
+  static constexpr std::size_t MAX_ENTRY_SIZE = 21 + ActionArgs::CAPACITY;
+
+  template <typename T>
+  static void writeValue(std::vector<std::byte> &out, const T &value) {
+    const auto *bytes = reinterpret_cast<const std::byte *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+  }
+
+  template <typename T>
+  static bool readValue(std::span<const std::byte> blob, std::size_t &offset,
+                        T &value) {
+    if (blob.size() - offset < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, blob.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+  }
+
+  TickBudgetReport drain(int current_tick, entt::registry &registry,
+                         entt::dispatcher &dispatcher,
+                         const TickBudget *budget) {
+    TickBudgetReport report;
+
+#ifdef SCHEDULER_METRICS
+    if (metrics) {
+      metrics->beginTick(current_tick, queue.size(), activeActions.size());
+    }
+#endif
+
+    // Resume coroutine tasks waiting on this tick
+    tasks.resumeDue(current_tick);
+
+    while (!queue.empty() && queue.front().tick <= current_tick) {
+      // Always make progress, then stop once the budget is spent
+      if (budget && report.executed > 0 && budget->exhausted()) {
+        report.budgetExhausted = true;
+        report.deferred = countDue(current_tick);
+        break;
+      }
+
+      std::pop_heap(queue.begin(), queue.end());
+      ScheduledAction action = std::move(queue.back());
+      queue.pop_back();
 
       // Skip if the action was cancelled
       if (activeActions.find(action.id) == activeActions.end()) {
@@ -72,6 +362,10 @@ public:
 
       // Execute the action if the entity is still valid
       if (registry.valid(action.entity)) {
+#ifdef SCHEDULER_METRICS
+        auto started = SchedulerMetrics::Clock::now();
+#endif
+
         // Execute main action
         action.action(action.entity, registry);
 
@@ -83,23 +377,49 @@ public:
         if (action.onComplete) {
           action.onComplete(action.id, action.entity, registry, dispatcher);
         }
+
+        report.executed++;
+
+#ifdef SCHEDULER_METRICS
+        if (metrics) {
+          metrics->recordAction(action.label ? action.label : "",
+                                current_tick - action.tick, started);
+        }
+#endif
       }
 
       // Remove from active actions
       activeActions.erase(action.id);
     }
+
+    if (budget) {
+      report.elapsed = budget->elapsed();
+    }
+
+#ifdef SCHEDULER_METRICS
+    if (metrics) {
+      metrics->recordDeferred(report.deferred);
+      metrics->endTick();
+    }
+#endif
+
+    return report;
   }
 
-  // Clear all pending actions
-  void clear() {
-    // Clear the queue - we have to rebuild it
-    std::priority_queue<ScheduledAction> empty;
-    std::swap(queue, empty);
-    activeActions.clear();
+  // Live actions that are due but still queued; only needed when deferring
+  std::size_t countDue(int current_tick) const {
+    return std::count_if(queue.begin(), queue.end(),
+                         [&](const ScheduledAction &action) {
+                           return action.tick <= current_tick &&
+                                  activeActions.count(action.id) > 0;
+                         });
   }
 
-private:
-  std::priority_queue<ScheduledAction> queue;
+  std::vector<ScheduledAction> queue; // Heap ordered by operator<
   std::unordered_set<ActionID> activeActions;
+  TaskQueue tasks;
   ActionID nextActionId;
+#ifdef SCHEDULER_METRICS
+  SchedulerMetrics *metrics = nullptr;
+#endif
 };
\ No newline at end of file
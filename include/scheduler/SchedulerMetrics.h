@@ -0,0 +1,293 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Optional instrumentation for Scheduler and TimedEventScheduler.
+//
+// The recording hooks inside the schedulers are only compiled when
+// SCHEDULER_METRICS is defined (CMake option ENABLE_SCHEDULER_METRICS). Without
+// it the schedulers carry no timing code at all and a SchedulerMetrics object
+// simply stays empty.
+class SchedulerMetrics {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::size_t HISTORY_SIZE = 300;
+  // Execution time buckets: <1us, <2us, <4us, ... , >=2^(N-2)us
+  static constexpr std::size_t HISTOGRAM_BUCKETS = 16;
+
+  static constexpr bool compiledIn() {
+#ifdef SCHEDULER_METRICS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  struct TickSample {
+    int tick = 0;
+    std::uint32_t queueDepth = 0;  // Entries in the queue, cancelled included
+    std::uint32_t activeCount = 0; // Entries that are still live
+    std::uint32_t executed = 0;
+    std::uint32_t deferred = 0; // Due entries left over by a budgeted update
+    int maxLateness = 0;
+    std::uint64_t totalLateness = 0;
+    std::uint64_t busyNs = 0;
+  };
+
+  struct LabelStats {
+    std::uint64_t count = 0;
+    std::uint64_t totalNs = 0;
+    std::uint64_t maxNs = 0;
+    std::uint64_t totalLateness = 0;
+    std::array<std::uint32_t, HISTOGRAM_BUCKETS> histogram{};
+  };
+
+  explicit SchedulerMetrics(std::string name) : name(std::move(name)) {}
+
+  const std::string &getName() const { return name; }
+
+  // Called by a scheduler before it drains due entries
+  void beginTick(int tick, std::size_t queueDepth, std::size_t activeCount) {
+    current = TickSample{};
+    current.tick = tick;
+    current.queueDepth = static_cast<std::uint32_t>(queueDepth);
+    current.activeCount = static_cast<std::uint32_t>(activeCount);
+  }
+
+  // Called by a scheduler after each executed entry
+  void recordAction(std::string_view label, int lateness,
+                    Clock::time_point started) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       Clock::now() - started)
+                       .count();
+    auto ns = static_cast<std::uint64_t>(elapsed);
+
+    current.executed++;
+    current.busyNs += ns;
+    current.totalLateness += static_cast<std::uint64_t>(lateness);
+    if (lateness > current.maxLateness) {
+      current.maxLateness = lateness;
+    }
+
+    if (label.empty()) {
+      label = "unlabeled";
+    }
+    auto it = labels.find(label);
+    if (it == labels.end()) {
+      it = labels.emplace(std::string(label), LabelStats{}).first;
+    }
+
+    LabelStats &stats = it->second;
+    stats.count++;
+    stats.totalNs += ns;
+    stats.totalLateness += static_cast<std::uint64_t>(lateness);
+    if (ns > stats.maxNs) {
+      stats.maxNs = ns;
+    }
+    stats.histogram[bucketFor(ns)]++;
+  }
+
+  // Called by a budgeted update that ran out of time
+  void recordDeferred(std::size_t count) {
+    current.deferred = static_cast<std::uint32_t>(count);
+  }
+
+  // Called by a scheduler once the tick has been processed
+  void endTick() {
+    history[historyIndex] = current;
+    historyIndex = (historyIndex + 1) % HISTORY_SIZE;
+    if (historyCount < HISTORY_SIZE) {
+      historyCount++;
+    }
+  }
+
+  // Visit recorded ticks from oldest to newest
+  void forEachTick(const std::function<void(const TickSample &)> &fn) const {
+    std::size_t start = (historyIndex + HISTORY_SIZE - historyCount) %
+                        HISTORY_SIZE;
+    for (std::size_t i = 0; i < historyCount; ++i) {
+      fn(history[(start + i) % HISTORY_SIZE]);
+    }
+  }
+
+  const TickSample &latest() const {
+    return history[(historyIndex + HISTORY_SIZE - 1) % HISTORY_SIZE];
+  }
+  std::size_t tickCount() const { return historyCount; }
+
+  const auto &getLabelStats() const { return labels; }
+
+  void reset() {
+    history = {};
+    historyIndex = 0;
+    historyCount = 0;
+    labels.clear();
+  }
+
+  // Lower bound of a histogram bucket in microseconds
+  static std::uint64_t bucketLowerBoundUs(std::size_t bucket) {
+    return bucket == 0 ? 0 : (std::uint64_t{1} << (bucket - 1));
+  }
+
+  // Writes <basePath>_ticks.csv and <basePath>_actions.csv
+  bool exportCsv(const std::string &basePath) const {
+    std::ofstream ticks(basePath + "_ticks.csv");
+    std::ofstream actions(basePath + "_actions.csv");
+    if (!ticks || !actions) {
+      return false;
+    }
+
+    ticks << "tick,queue_depth,active,executed,deferred,max_lateness,"
+             "avg_lateness,busy_us\n";
+    forEachTick([&](const TickSample &sample) {
+      double avgLateness =
+          sample.executed ? static_cast<double>(sample.totalLateness) /
+                                sample.executed
+                          : 0.0;
+      ticks << sample.tick << ',' << sample.queueDepth << ','
+            << sample.activeCount << ',' << sample.executed << ','
+            << sample.deferred << ',' << sample.maxLateness << ','
+            << avgLateness << ',' << sample.busyNs / 1000.0 << '\n';
+    });
+
+    actions << "label,count,avg_us,max_us,avg_lateness";
+    for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+      actions << ",ge_" << bucketLowerBoundUs(i) << "us";
+    }
+    actions << '\n';
+    for (const auto &[label, stats] : labels) {
+      writeCsvString(actions, label);
+      actions << ',' << stats.count << ','
+              << averageUs(stats) << ',' << stats.maxNs / 1000.0 << ','
+              << static_cast<double>(stats.totalLateness) / stats.count;
+      for (auto bucketCount : stats.histogram) {
+        actions << ',' << bucketCount;
+      }
+      actions << '\n';
+    }
+
+    return true;
+  }
+
+  bool exportJson(const std::string &path) const {
+    std::ofstream out(path);
+    if (!out) {
+      return false;
+    }
+
+    out << "{\n  \"scheduler\": ";
+    writeJsonString(out, name);
+    out << ",\n  \"ticks\": [";
+    bool first = true;
+    forEachTick([&](const TickSample &sample) {
+      out << (first ? "\n" : ",\n") << "    {\"tick\": " << sample.tick
+          << ", \"queue_depth\": " << sample.queueDepth
+          << ", \"active\": " << sample.activeCount
+          << ", \"executed\": " << sample.executed
+          << ", \"deferred\": " << sample.deferred
+          << ", \"max_lateness\": " << sample.maxLateness
+          << ", \"busy_us\": " << sample.busyNs / 1000.0 << "}";
+      first = false;
+    });
+    out << "\n  ],\n  \"actions\": [";
+
+    first = true;
+    for (const auto &[label, stats] : labels) {
+      out << (first ? "\n" : ",\n") << "    {\"label\": ";
+      writeJsonString(out, label);
+      out << ", \"count\": " << stats.count
+          << ", \"avg_us\": " << averageUs(stats)
+          << ", \"max_us\": " << stats.maxNs / 1000.0 << ", \"histogram\": [";
+      for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        out << (i ? ", " : "") << stats.histogram[i];
+      }
+      out << "]}";
+      first = false;
+    }
+    out << "\n  ]\n}\n";
+
+    return true;
+  }
+
+  static double averageUs(const LabelStats &stats) {
+    return stats.count ? stats.totalNs / 1000.0 / stats.count : 0.0;
+  }
+
+private:
+  struct LabelHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view label) const {
+      return std::hash<std::string_view>{}(label);
+    }
+  };
+
+  // Labels are free text, so quote them the way each format needs
+  static void writeCsvString(std::ostream &out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+      if (c == '"') {
+        out << '"'; // A quote inside a quoted field is doubled
+      }
+      out << c;
+    }
+    out << '"';
+  }
+
+  static void writeJsonString(std::ostream &out, std::string_view text) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    out << '"';
+    for (char c : text) {
+      switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\r':
+        out << "\\r";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u00" << HEX[c >> 4] << HEX[c & 0xf];
+        } else {
+          out << c;
+        }
+      }
+    }
+    out << '"';
+  }
+
+  static std::size_t bucketFor(std::uint64_t ns) {
+    std::uint64_t us = ns / 1000;
+    std::size_t bucket = 0;
+    while (us > 0 && bucket < HISTOGRAM_BUCKETS - 1) {
+      us >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+  std::string name;
+  TickSample current;
+  std::array<TickSample, HISTORY_SIZE> history{};
+  std::size_t historyIndex = 0;
+  std::size_t historyCount = 0;
+  std::unordered_map<std::string, LabelStats, LabelHash, std::equal_to<>>
+      labels;
+};
@@ -13,19 +13,52 @@ struct Health {
 
 namespace SchedulerUtils {
 
+// Built-in "damage" action type and its arguments
+inline constexpr entt::hashed_string DAMAGE_ACTION{"damage"};
+
+struct DamageArgs {
+  int amount = 0;
+};
+
+inline void applyDamage(entt::entity entity, entt::registry &registry,
+                        const DamageArgs &args) {
+  if (registry.valid(entity) && registry.all_of<Health>(entity)) {
+    registry.get<Health>(entity).current -= args.amount;
+  }
+}
+
+// Define the action types the helpers below rely on
+inline void registerBuiltinActions(ActionRegistry &types) {
+  types.define<DamageArgs>(DAMAGE_ACTION, &applyDamage);
+}
+
+// Expand a batch ID range into the list form these helpers return
+inline std::vector<ActionID> toIdList(const ActionIDRange &range) {
+  std::vector<ActionID> actionIds;
+  actionIds.reserve(range.size());
+  for (std::size_t i = 0; i < range.size(); ++i) {
+    actionIds.push_back(range[i]);
+  }
+  return actionIds;
+}
+
 // Schedule damage over time (like poison, burning, etc.)
 inline std::vector<ActionID> scheduleDamageOverTime(
     Scheduler &scheduler, entt::entity target, int damage, int totalTicks,
     int interval, int startTick,
     std::function<void(entt::entity, int)> onDamage = nullptr) {
+  if (totalTicks <= 0) {
+    return {};
+  }
 
-  std::vector<ActionID> actionIds;
+  std::vector<ScheduledAction> batch;
+  batch.reserve(totalTicks);
 
   for (int i = 0; i < totalTicks; ++i) {
     int tick = startTick + (i * interval);
 
-    ActionID id = scheduler.schedule(
-        tick, target,
+    batch.push_back(ScheduledAction{
+        0, tick, target,
         [damage, onDamage](entt::entity entity, entt::registry &registry) {
           if (registry.valid(entity) && registry.all_of<Health>(entity)) {
             auto &health = registry.get<Health>(entity);
@@ -35,12 +68,37 @@ inline std::vector<ActionID> scheduleDamageOverTime(
               onDamage(entity, damage);
             }
           }
-        });
+        },
+        nullptr, "damage_over_time"});
+  }
+
+  return toIdList(scheduler.scheduleBatch(batch));
+}
 
-    actionIds.push_back(id);
+// Serializable variant of the above built on the "damage" action type. There
+// is no per-hit callback, so the pending ticks survive Scheduler::serialize.
+// Schedules nothing if the "damage" type isn't registered.
+inline std::vector<ActionID> scheduleDamageOverTime(
+    Scheduler &scheduler, const ActionRegistry &types, entt::entity target,
+    int damage, int totalTicks, int interval, int startTick) {
+  if (!types.contains(DAMAGE_ACTION)) {
+    std::cerr << "Unknown action type: " << DAMAGE_ACTION.data() << std::endl;
+    return {};
+  }
+  if (totalTicks <= 0) {
+    return {};
   }
 
-  return actionIds;
+  std::vector<ScheduledAction> batch;
+  batch.reserve(totalTicks);
+
+  ActionArgs args = ActionArgs::pack(DamageArgs{damage});
+  for (int i = 0; i < totalTicks; ++i) {
+    batch.push_back(Scheduler::makeAction(
+        types, startTick + (i * interval), target, DAMAGE_ACTION, args));
+  }
+
+  return toIdList(scheduler.scheduleBatch(batch));
 }
 
 // Schedule an attack with a callback when done
@@ -81,16 +139,19 @@ inline ActionID scheduleDelayedAction(
 inline std::vector<ActionID> scheduleRecurringAction(
     Scheduler &scheduler, entt::entity entity, int interval, int count,
     int startTick, std::function<void(entt::entity, entt::registry &)> action) {
+  if (count <= 0) {
+    return {};
+  }
 
-  std::vector<ActionID> actionIds;
+  std::vector<ScheduledAction> batch;
+  batch.reserve(count);
 
   for (int i = 0; i < count; ++i) {
     int tick = startTick + (i * interval);
-    ActionID id = scheduler.schedule(tick, entity, action);
-    actionIds.push_back(id);
+    batch.push_back(ScheduledAction{0, tick, entity, action, nullptr});
   }
 
-  return actionIds;
+  return toIdList(scheduler.scheduleBatch(batch));
 }
 
 // Schedule an action chain (one after another)
@@ -100,14 +161,15 @@ inline std::vector<ActionID> scheduleActionChain(
         std::pair<int, std::function<void(entt::entity, entt::registry &)>>>
         actions) {
 
-  std::vector<ActionID> actionIds;
+  std::vector<ScheduledAction> batch;
+  batch.reserve(actions.size());
 
-  for (const auto &[delay, action] : actions) {
-    ActionID id = scheduler.schedule(delay, entity, action);
-    actionIds.push_back(id);
+  for (auto &[delay, action] : actions) {
+    batch.push_back(
+        ScheduledAction{0, delay, entity, std::move(action), nullptr});
   }
 
-  return actionIds;
+  return toIdList(scheduler.scheduleBatch(batch));
 }
 
 } // namespace SchedulerUtils
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+// Wall-clock allowance for one scheduler update. Once it runs out the
+// scheduler stops draining and leaves the remaining due work for the next
+// tick, where it is picked up first because it is the oldest.
+class TickBudget {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit TickBudget(std::chrono::microseconds allowance)
+      : started(Clock::now()), deadline(started + allowance) {}
+
+  bool exhausted() const { return Clock::now() >= deadline; }
+
+  std::chrono::microseconds elapsed() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - started);
+  }
+
+private:
+  Clock::time_point started;
+  Clock::time_point deadline;
+};
+
+// Outcome of a budgeted scheduler update
+struct TickBudgetReport {
+  std::size_t executed = 0;
+  std::size_t deferred = 0; // Due entries pushed to the next tick
+  std::chrono::microseconds elapsed{0};
+  bool budgetExhausted = false;
+};
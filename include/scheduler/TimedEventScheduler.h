@@ -1,10 +1,13 @@
 #pragma once
 
+#include "SchedulerMetrics.h"
+#include "TickBudget.h"
+#include <algorithm>
 #include <functional>
 #include <memory>
-#include <queue>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 using EventID = uint32_t;
 
@@ -86,7 +89,8 @@ public:
     EventID eventId = nextEventId++;
     event->setId(eventId);
     event->setScheduler(this);
-    eventQueue.push(event);
+    eventQueue.push_back(std::move(event));
+    std::push_heap(eventQueue.begin(), eventQueue.end(), TimedEventCompare{});
     activeEvents.insert(eventId);
     return eventId;
   }
@@ -101,45 +105,113 @@ public:
   }
 
   // Process events due at the current tick
-  void update(int currentTick) {
-    while (!eventQueue.empty() && eventQueue.top()->getTick() <= currentTick) {
-      auto event = eventQueue.top();
-      eventQueue.pop();
+  void update(int currentTick) { drain(currentTick, nullptr); }
+
+  // Process due events until the budget runs out. Events run in
+  // (tick, priority) order, so the lowest-priority events of the newest tick
+  // are deferred; they stay queued and run first on the next update.
+  TickBudgetReport update(int currentTick, std::chrono::microseconds budget) {
+    TickBudget tickBudget(budget);
+    return drain(currentTick, &tickBudget);
+  }
+
+  // Attach an instrumentation sink (no-op unless SCHEDULER_METRICS is set)
+  void setMetrics([[maybe_unused]] SchedulerMetrics *sink) {
+#ifdef SCHEDULER_METRICS
+    metrics = sink;
+#endif
+  }
+
+  std::size_t pendingCount() const { return activeEvents.size(); }
+
+  // Schedule a simple function to run at a specific tick
+  EventID scheduleFunction(int tick, std::function<void()> func,
+                           std::string name = "") {
+    return scheduleEvent<FunctionEvent>(tick, std::move(func), std::move(name));
+  }
+
+  // Clear all pending events
+  void clear() {
+    eventQueue.clear();
+    activeEvents.clear();
+  }
+
+private:
+  TickBudgetReport drain(int currentTick, const TickBudget *budget) {
+    TickBudgetReport report;
+
+#ifdef SCHEDULER_METRICS
+    if (metrics) {
+      metrics->beginTick(currentTick, eventQueue.size(), activeEvents.size());
+    }
+#endif
+
+    while (!eventQueue.empty() &&
+           eventQueue.front()->getTick() <= currentTick) {
+      // Always make progress, then stop once the budget is spent
+      if (budget && report.executed > 0 && budget->exhausted()) {
+        report.budgetExhausted = true;
+        report.deferred = countDue(currentTick);
+        break;
+      }
+
+      std::pop_heap(eventQueue.begin(), eventQueue.end(), TimedEventCompare{});
+      auto event = std::move(eventQueue.back());
+      eventQueue.pop_back();
 
       // Skip if the event was cancelled
       if (activeEvents.find(event->getId()) == activeEvents.end()) {
         continue;
       }
 
+#ifdef SCHEDULER_METRICS
+      auto started = SchedulerMetrics::Clock::now();
+#endif
+
       // Execute the event
       event->execute();
+      report.executed++;
+
+#ifdef SCHEDULER_METRICS
+      if (metrics) {
+        metrics->recordAction(event->getName(), currentTick - event->getTick(),
+                              started);
+      }
+#endif
 
       // Remove from active events
       activeEvents.erase(event->getId());
     }
-  }
 
-  // Schedule a simple function to run at a specific tick
-  EventID scheduleFunction(int tick, std::function<void()> func,
-                           std::string name = "") {
-    return scheduleEvent<FunctionEvent>(tick, std::move(func), std::move(name));
+    if (budget) {
+      report.elapsed = budget->elapsed();
+    }
+
+#ifdef SCHEDULER_METRICS
+    if (metrics) {
+      metrics->recordDeferred(report.deferred);
+      metrics->endTick();
+    }
+#endif
+
+    return report;
   }
 
-  // Clear all pending events
-  void clear() {
-    std::priority_queue<std::shared_ptr<TimedEvent>,
-                        std::vector<std::shared_ptr<TimedEvent>>,
-                        TimedEventCompare>
-        empty;
-    std::swap(eventQueue, empty);
-    activeEvents.clear();
+  // Live events that are due but still queued; only needed when deferring
+  std::size_t countDue(int currentTick) const {
+    return std::count_if(
+        eventQueue.begin(), eventQueue.end(),
+        [&](const std::shared_ptr<TimedEvent> &event) {
+          return event->getTick() <= currentTick &&
+                 activeEvents.count(event->getId()) > 0;
+        });
   }
 
-private:
-  std::priority_queue<std::shared_ptr<TimedEvent>,
-                      std::vector<std::shared_ptr<TimedEvent>>,
-                      TimedEventCompare>
-      eventQueue;
+  // Heap ordered by TimedEventCompare
+  std::vector<std::shared_ptr<TimedEvent>> eventQueue;
   std::unordered_set<EventID> activeEvents;
   EventID nextEventId;
+#ifdef SCHEDULER_METRICS
+  SchedulerMetrics *metrics = nullptr;
+#endif
 };
\ No newline at end of file
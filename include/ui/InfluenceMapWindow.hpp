@@ -0,0 +1,26 @@
+#pragma once
+
+#include "navigation/InfluenceMap.hpp"
+#include "ui/DebugWindow.hpp"
+#include <entt/entt.hpp>
+#include <string>
+
+namespace UI {
+
+// Heat map of one InfluenceMap layer, one square per coarse cell, scaled to
+// the layer's current peak. Hovering a cell shows its value.
+class InfluenceMapWindow : public DebugWindow {
+public:
+  InfluenceMapWindow(const std::string &title, bool *show = nullptr);
+  void render(entt::registry &registry) override;
+
+  void setInfluenceMap(const Navigation::InfluenceMap *map) {
+    influence = map;
+  }
+
+private:
+  const Navigation::InfluenceMap *influence = nullptr;
+  int layer = Navigation::InfluenceMap::Crowd;
+};
+
+} // namespace UI
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/SystemScheduler.hpp"
 #include "ui/DebugWindow.hpp"
 #include <SDL2/SDL.h>
 #include <array>
@@ -14,6 +15,9 @@ public:
   PerformanceWindow(const std::string &title, bool *show);
   void render(entt::registry &registry) override;
   void updateTickRate(Uint32 currentTick, Uint32 currentTime);
+  void setSystemScheduler(const Core::SystemScheduler *scheduler) {
+    systems = scheduler;
+  }
 
 private:
   static constexpr size_t HISTORY_SIZE = 60;
@@ -47,6 +51,9 @@ private:
   float lastUserTime = 0.0f;   // Last recorded user CPU time
   float lastSystemTime = 0.0f; // Last recorded system CPU time
 
+  // Per-system timings from the simulation's system graph
+  const Core::SystemScheduler *systems = nullptr;
+
   // Helper methods
   void updateFPS();
   void updateMemoryUsage();
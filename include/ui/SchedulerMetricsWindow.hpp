@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../scheduler/SchedulerMetrics.h"
+#include "../scheduler/TickBudget.h"
+#include "DebugWindow.hpp"
+#include <string>
+#include <vector>
+
+namespace UI {
+
+// Shows queue depth, throughput, lateness and per-action cost for every
+// attached SchedulerMetrics sink, with CSV/JSON export
+class SchedulerMetricsWindow : public DebugWindow {
+public:
+  SchedulerMetricsWindow(const std::string &title, bool *show = nullptr);
+  void render(entt::registry &registry) override;
+
+  void addSource(SchedulerMetrics *metrics) { m_sources.push_back(metrics); }
+  void setBudgetReport(const TickBudgetReport &report) {
+    m_budgetReport = report;
+  }
+
+private:
+  void renderSource(SchedulerMetrics &metrics);
+  void renderLabelTable(const SchedulerMetrics &metrics);
+
+  std::vector<SchedulerMetrics *> m_sources;
+  TickBudgetReport m_budgetReport;
+  std::string m_lastExportMessage;
+};
+
+} // namespace UI
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "core/Components.h"
+#include "core/services/JobSystem.hpp"
+#include "vision/OpacityGrid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+
+namespace Vision {
+
+// Keeps every FieldOfViewComponent current. An entity's field is recomputed
+// only when it changes cell or radius, or a cell within its radius changes
+// opacity; the rest keep their bits. Fields are computed with symmetric
+// shadowcasting: a cell is visible from an entity exactly when the entity is
+// visible from the cell, so "I can see you" never disagrees with "you can
+// see me".
+class FieldOfViewSystem {
+public:
+  using Viewers =
+      entt::view<entt::get_t<const Components::PositionComponent,
+                             Components::FieldOfViewComponent>>;
+
+  // Recompute the stale fields, spread over the job system. Returns how
+  // many were recomputed.
+  std::size_t update(const Viewers &viewers, const OpacityGrid &grid,
+                     Core::Services::JobSystem &jobs);
+
+  // Compute one field from (x, y) into field
+  static void compute(const OpacityGrid &grid, int x, int y, int radius,
+                      Components::FieldOfViewComponent &field);
+
+  std::size_t getRecomputeCount() const { return recomputes; }
+
+private:
+  std::uint32_t buildVersion = 0;
+  std::size_t editsSeen = 0;
+  std::size_t recomputes = 0;
+};
+
+} // namespace Vision
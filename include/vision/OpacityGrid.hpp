@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace Vision {
+
+// Cells that block sight, one bit each in rows of 64-bit words over the
+// map's bounding box. Built from cells holding a static blocking collider
+// (TileColliderTag); cells outside the box block sight too. Like NavGrid,
+// rebuilding to the same extent logs the cells that changed as edits.
+class OpacityGrid {
+public:
+  void build(const entt::registry &registry);
+  void clear();
+  // Change one cell in place, e.g. when a wall is dug out
+  void setOpaque(int x, int y, bool value);
+
+  bool contains(int x, int y) const {
+    return x >= originX && y >= originY && x < originX + width &&
+           y < originY + height;
+  }
+  bool isOpaque(int x, int y) const {
+    if (!contains(x, y)) {
+      return true;
+    }
+    const int col = x - originX;
+    return (words[(y - originY) * wordsPerRow + col / 64] >> (col % 64)) & 1;
+  }
+
+  int getOriginX() const { return originX; }
+  int getOriginY() const { return originY; }
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+  // Same meaning as on NavGrid; edits are (x, y) cells
+  struct Cell {
+    int x;
+    int y;
+  };
+  std::uint32_t getVersion() const { return version; }
+  std::uint32_t getBuildVersion() const { return buildVersion; }
+  const std::vector<Cell> &getEdits() const { return edits; }
+
+private:
+  int originX = 0;
+  int originY = 0;
+  int width = 0;
+  int height = 0;
+  int wordsPerRow = 0;
+  std::vector<std::uint64_t> words;
+  std::vector<Cell> edits;
+  std::uint32_t version = 0;
+  std::uint32_t buildVersion = 0;
+};
+
+} // namespace Vision
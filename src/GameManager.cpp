@@ -51,13 +51,11 @@ GameManager::~GameManager()
 void GameManager::setupEventHandlers()
 {
     // Log player movement events
-    eventBus.subscribe(GameEventType::PLAYER_MOVED,
-                       [](const GameEvent &event)
+    eventBus.subscribe<PlayerMovedEvent, [](const PlayerMovedEvent &e)
                        {
-                           const auto &e = static_cast<const PlayerMovedEvent &>(event);
                            std::cout << "🟢 Player moved to: (" << e.newX << ", " << e.newY
                                      << ")\n";
-                       });
+                       }>();
 
     // You can add more event handlers here
 }
@@ -244,6 +242,9 @@ void GameManager::update()
         // Reload tilesets if needed
         loadTilesets();
     }
+
+    // Deliver events queued during this update
+    eventBus.flush();
 }
 
 void GameManager::render()
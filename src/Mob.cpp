@@ -90,8 +90,8 @@ bool Mob::move(int dx, int dy, EventBus &bus) {
     // Update local position
     position = newPos;
 
-    // Publish movement event
-    bus.publish(MobMovedEvent(position.x, position.y));
+    // Queue movement event; delivered on the next flush
+    bus.enqueue(MobMovedEvent{entity, position.x, position.y});
     return true;
   }
 
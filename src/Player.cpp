@@ -68,7 +68,7 @@ bool Player::move(int dx, int dy, EventBus &bus)
         position = newPos;
 
         // Publish movement event
-        bus.publish(PlayerMovedEvent(position.x, position.y));
+        bus.publish(PlayerMovedEvent{entity, position.x, position.y});
         return true;
     }
 
@@ -67,8 +67,9 @@ bool TmxMapLoader::loadMap(const std::string &filepath, entt::registry &reg) {
   lastModifiedTime = std::filesystem::last_write_time(filepath);
   loaded = true;
 
-  // Load all tileset textures
-  for (int i = 0; i < map.GetNumTilesets(); ++i) {
+  // Load all tileset textures. Headless runs have no renderer and only need
+  // the entities built below.
+  for (int i = 0; renderer && i < map.GetNumTilesets(); ++i) {
     const Tmx::Tileset *tileset = map.GetTileset(i);
     if (!tileset)
       continue;
@@ -0,0 +1,66 @@
+#include "core/AiLodSystem.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace Systems {
+
+namespace {
+
+template <typename Tag>
+void moveToBucket(entt::registry &registry, entt::entity entity) {
+  if (registry.all_of<Tag>(entity)) {
+    return;
+  }
+  registry.remove<Components::AiLodNearTag, Components::AiLodMidTag,
+                  Components::AiLodFarTag, Components::AiLodDormantTag>(
+      entity);
+  registry.emplace<Tag>(entity);
+}
+
+} // namespace
+
+void AiLodSystem(entt::registry &registry, Uint32 currentTick) {
+  auto players = registry.view<const Components::PositionComponent,
+                               const Components::PlayerMarker>();
+  auto distanceToPlayer = [&](const Components::PositionComponent &pos) {
+    int nearest = INT_MAX;
+    for (auto [player, playerPos] : players.each()) {
+      nearest = std::min(nearest, std::max(std::abs(playerPos.x - pos.x),
+                                           std::abs(playerPos.y - pos.y)));
+    }
+    return nearest;
+  };
+
+  // This tick's slice of the mobs, taken straight from the storage so the
+  // rest aren't touched
+  const auto &wanderers = registry.storage<Components::WanderComponent>();
+  const std::size_t count = wanderers.size();
+  const std::size_t slice =
+      (count + AI_LOD_REBUCKET_PERIOD - 1) / AI_LOD_REBUCKET_PERIOD;
+  const std::size_t begin = currentTick % AI_LOD_REBUCKET_PERIOD * slice;
+  const std::size_t end = std::min(count, begin + slice);
+
+  for (std::size_t i = begin; i < end; ++i) {
+    const entt::entity entity = wanderers.data()[i];
+    const auto *pos = registry.try_get<Components::PositionComponent>(entity);
+    if (!pos) {
+      continue;
+    }
+    // Without a player there is nothing to be far from
+    const int distance = players.begin() == players.end()
+                             ? 0
+                             : distanceToPlayer(*pos);
+    if (distance <= AI_LOD_NEAR_RANGE) {
+      moveToBucket<Components::AiLodNearTag>(registry, entity);
+    } else if (distance <= AI_LOD_MID_RANGE) {
+      moveToBucket<Components::AiLodMidTag>(registry, entity);
+    } else if (distance <= AI_LOD_FAR_RANGE) {
+      moveToBucket<Components::AiLodFarTag>(registry, entity);
+    } else {
+      moveToBucket<Components::AiLodDormantTag>(registry, entity);
+    }
+  }
+}
+
+} // namespace Systems
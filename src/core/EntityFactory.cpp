@@ -7,6 +7,8 @@ entt::entity EntityFactory::createPlayer(int x, int y,
   return createEntity(x, y, Components::TestComponent{},
                       Components::CollisionComponent{false},
                       Components::PlayerMarker{},
+                      Components::FieldOfViewComponent{
+                          Constants::Game::PLAYER_SIGHT},
                       Components::SpriteComponent{
                           tilesetName, Constants::Sprites::IDs::PLAYER});
 }
@@ -0,0 +1,129 @@
+#include "core/HeadlessRuntime.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Core {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Silences std::cout for its lifetime. Movement logging dominates tick cost
+// otherwise, and it is not what a throughput run should measure.
+class ScopedMute {
+public:
+  explicit ScopedMute(bool mute) : muted(mute) {
+    if (muted) {
+      std::cout.setstate(std::ios::badbit);
+    }
+  }
+  ~ScopedMute() {
+    if (muted) {
+      std::cout.clear();
+    }
+  }
+
+private:
+  bool muted;
+};
+
+void printRate(const char *what, int ticks, double seconds) {
+  std::cout << what << " " << ticks << " ticks in " << seconds << " s ("
+            << (seconds > 0 ? ticks / seconds : 0.0) << " ticks/s)"
+            << std::endl;
+}
+
+} // namespace
+
+HeadlessRuntime::HeadlessRuntime(const Options &options) : options(options) {
+  simulation.setMapLoader(&mapLoader);
+  auto &scenario = simulation.getScenario();
+  scenario.usingDungeonGenerator = options.useTmxMap ? 0 : 1;
+  if (options.log) {
+    simulation.getWanderSystem().setTraceSink(
+        Systems::WanderSystem::printTrace);
+  }
+}
+
+int HeadlessRuntime::run() {
+  return options.replayPath.empty() ? runLive() : runReplay();
+}
+
+int HeadlessRuntime::runLive() {
+  {
+    ScopedMute mute(!options.log);
+    bool ready = options.recordPath.empty()
+                     ? simulation.resetScenario()
+                     : simulation.startRecording(options.recordPath);
+    if (!ready) {
+      std::cerr << "Failed to set up the headless scenario" << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << "Running " << options.ticks << " headless ticks..."
+            << std::endl;
+
+  Clock::duration slowest{0};
+  auto started = Clock::now();
+  {
+    ScopedMute mute(!options.log);
+    // Ticks run back to back; the simulation's own tick count is its clock
+    for (int i = 0; i < options.ticks; ++i) {
+      auto tickStart = Clock::now();
+      simulation.tick({});
+      slowest = std::max(slowest, Clock::now() - tickStart);
+    }
+  }
+  auto elapsed = Clock::now() - started;
+  simulation.stopRecording();
+
+  double seconds = std::chrono::duration<double>(elapsed).count();
+  printRate("Simulated", options.ticks, seconds);
+  if (options.ticks > 0) {
+    std::cout << "Mean tick "
+              << std::chrono::duration<double, std::micro>(elapsed).count() /
+                     options.ticks
+              << " us, slowest "
+              << std::chrono::duration<double, std::micro>(slowest).count()
+              << " us" << std::endl;
+  }
+  for (const auto &timing : simulation.getSystems().getTimings()) {
+    std::cout << "  " << timing.name << ": avg " << timing.averageUs
+              << " us, slowest "
+              << std::chrono::duration<double, std::micro>(timing.slowest)
+                     .count()
+              << " us" << std::endl;
+  }
+  return 0;
+}
+
+int HeadlessRuntime::runReplay() {
+  Replay::JournalReader reader;
+  if (!reader.open(options.replayPath)) {
+    return 1;
+  }
+  std::cout << "Replaying journal (" << reader.size() << " bytes)..."
+            << std::endl;
+
+  auto started = Clock::now();
+  Simulation::ReplayResult result;
+  {
+    ScopedMute mute(!options.log);
+    result = simulation.replay(reader);
+  }
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - started).count();
+
+  printRate("Replayed", result.ticks, seconds);
+  if (result.divergedTicks > 0) {
+    std::cerr << "Replay diverged from the recording on "
+              << result.divergedTicks << " ticks, first at tick "
+              << result.firstDivergence << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+} // namespace Core
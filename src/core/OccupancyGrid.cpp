@@ -0,0 +1,90 @@
+#include "core/OccupancyGrid.hpp"
+#include "core/Components.h"
+#include <algorithm>
+#include <climits>
+
+namespace Core {
+
+void OccupancyGrid::build(const entt::registry &registry) {
+  auto floors =
+      registry.view<Components::PositionComponent, Components::FloorTag>();
+  auto tiles = registry.view<Components::PositionComponent,
+                             Components::CollisionComponent,
+                             Components::TileColliderTag>();
+
+  int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+  auto extend = [&](const Components::PositionComponent &pos) {
+    minX = std::min(minX, pos.x);
+    minY = std::min(minY, pos.y);
+    maxX = std::max(maxX, pos.x);
+    maxY = std::max(maxY, pos.y);
+  };
+  for (auto [entity, pos] : floors.each()) {
+    extend(pos);
+  }
+  for (auto [entity, pos, collision] : tiles.each()) {
+    extend(pos);
+  }
+  if (minX > maxX) {
+    clear();
+    return;
+  }
+
+  originX = minX;
+  originY = minY;
+  width = maxX - minX + 1;
+  height = maxY - minY + 1;
+  walls.assign(static_cast<std::size_t>(width) * height, entt::null);
+  moving.assign(walls.size(), entt::null);
+  stamped.clear();
+
+  for (auto [entity, pos, collision] : tiles.each()) {
+    if (collision.isBlocking && walls[toIndex(pos.x, pos.y)] == entt::null) {
+      walls[toIndex(pos.x, pos.y)] = entity;
+    }
+  }
+  refresh(registry);
+}
+
+void OccupancyGrid::refresh(const entt::registry &registry) {
+  for (int index : stamped) {
+    moving[index] = entt::null;
+  }
+  stamped.clear();
+
+  auto colliders = registry.view<Components::PositionComponent,
+                                 Components::CollisionComponent>(
+      entt::exclude<Components::TileColliderTag, Components::FloorTag>);
+  for (auto [entity, pos, collision] : colliders.each()) {
+    if (!contains(pos.x, pos.y) ||
+        (!collision.isBlocking &&
+         !registry.all_of<Components::PlayerMarker>(entity))) {
+      continue;
+    }
+    const int index = toIndex(pos.x, pos.y);
+    if (moving[index] == entt::null) {
+      moving[index] = entity;
+      stamped.push_back(index);
+    }
+  }
+}
+
+void OccupancyGrid::moveOccupant(entt::entity entity, int fromX, int fromY,
+                                 int toX, int toY) {
+  if (contains(fromX, fromY) && moving[toIndex(fromX, fromY)] == entity) {
+    moving[toIndex(fromX, fromY)] = entt::null;
+  }
+  if (contains(toX, toY) && moving[toIndex(toX, toY)] == entt::null) {
+    moving[toIndex(toX, toY)] = entity;
+    stamped.push_back(toIndex(toX, toY));
+  }
+}
+
+void OccupancyGrid::clear() {
+  originX = originY = width = height = 0;
+  walls.clear();
+  moving.clear();
+  stamped.clear();
+}
+
+} // namespace Core
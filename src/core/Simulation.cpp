@@ -0,0 +1,485 @@
+#include "core/Simulation.hpp"
+#include "core/AiLodSystem.hpp"
+#include "core/CollisionSystem.h"
+#include "core/Constants.h"
+#include "core/Mob.h"
+#include "core/WanderSystem.hpp"
+#include <cstdlib>
+#include <iostream>
+
+namespace Core {
+
+namespace {
+
+// Flatten an event into the byte form compared during replay
+void appendTraffic(std::vector<std::byte> &traffic, std::uint8_t tag,
+                   std::span<const std::byte> payload) {
+  traffic.push_back(static_cast<std::byte>(tag));
+  traffic.insert(traffic.end(), payload.begin(), payload.end());
+}
+
+} // namespace
+
+Simulation::Simulation()
+    : entityFactory(registry), dungeonGenerator(100, 3, 10, 5, 8, 8),
+      scenario{0, 0, 100, 3, 10, 5, 8, 8} {
+  // Only the final position of each entity per tick is of interest
+  eventBus.coalesce<PlayerMovedEvent, [](const PlayerMovedEvent &event) {
+    return event.entity;
+  }>();
+  eventBus.coalesce<MobMovedEvent, [](const MobMovedEvent &event) {
+    return event.entity;
+  }>();
+
+  // The tick's systems, in registration order where their access overlaps
+  systems.add<&Simulation::inputSystem>(*this, "input");
+  systems.add<&Simulation::occupancySystem>(*this, "occupancy");
+  systems.add<&Simulation::aiLodSystem>(*this, "ai lod");
+  systems.add<&Simulation::flowFieldSystem>(*this, "flow field");
+  systems.add<&Simulation::fieldOfViewSystem>(*this, "field of view");
+  systems.add<&Simulation::pursuitSystem>(*this, "pursuit");
+  systems.add<&Simulation::wanderSystem>(*this, "wander");
+  systems.add<&Simulation::influenceSystem>(*this, "influence");
+  systems.add<&Simulation::schedulerSystem>(*this, "schedulers");
+}
+
+bool Simulation::resetScenario() {
+  Replay::ScenarioRecord settings = scenario;
+  settings.seed = static_cast<std::uint32_t>(seedSource());
+  return resetScenario(settings);
+}
+
+bool Simulation::resetScenario(const Replay::ScenarioRecord &settings) {
+  std::cout << "Starting setupTestScenario..." << std::endl;
+  scenario = settings;
+
+  if (journalWriter) {
+    journalWriter->write(currentTick, Replay::RecordKind::ScenarioReset,
+                         scenario);
+  }
+
+  // Seed everything random in the scenario so a journal can rebuild it
+  std::srand(scenario.seed);
+  dungeonGenerator.setParameters(scenario.totalFloorCount, scenario.minHall,
+                                 scenario.maxHall, scenario.roomDim,
+                                 scenario.tileWidth, scenario.tileHeight);
+  dungeonGenerator.setSeed(scenario.seed);
+
+  // Clear existing entities. clear() only recycles their ids with bumped
+  // versions, so drop those too: journaled events carry entity ids, and a
+  // recording made after earlier resets must match a fresh replaying world.
+  registry.clear();
+  registry.storage<entt::entity>().clear();
+
+  bool built = scenario.usingDungeonGenerator ? buildDungeonScenario()
+                                              : buildTmxScenario();
+  occupancy.build(registry);
+  navGrid.build(registry);
+  opacityGrid.build(registry);
+  influence.clear();
+  std::cout << "setupTestScenario completed" << std::endl;
+  return built;
+}
+
+bool Simulation::buildDungeonScenario() {
+  std::cout << "Generating dungeon..." << std::endl;
+  dungeonGenerator.generate();
+  std::cout << "Dungeon generated" << std::endl;
+
+  const auto &floors = dungeonGenerator.getFloors();
+  const auto &walls = dungeonGenerator.getWalls();
+
+  if (floors.empty()) {
+    std::cerr << "No floor tiles generated!" << std::endl;
+    return false;
+  }
+
+  // Create floor tiles
+  std::cout << "Creating floor tiles..." << std::endl;
+  for (const auto &floor : floors) {
+    entityFactory.createFloor(floor.x, floor.y,
+                              Constants::Sprites::Tilesets::MAIN_TILESET);
+  }
+  std::cout << "Floor tiles created" << std::endl;
+
+  // Create wall tiles with collision components
+  std::cout << "Creating wall tiles..." << std::endl;
+  for (const auto &wall : walls) {
+    entityFactory.createWall(wall.x, wall.y,
+                             Constants::Sprites::Tilesets::MAIN_TILESET);
+  }
+  std::cout << "Wall tiles created" << std::endl;
+
+  // Create player and mobs
+  entityFactory.createPlayer(floors[0].x, floors[0].y,
+                             Constants::Sprites::Tilesets::MAIN_TILESET);
+
+  // Create mobs at different positions, ensuring they have space to move
+  int mobsCreated = 0;
+  int attempts = 0;
+  const int maxAttempts = floors.size();
+
+  while (mobsCreated < 30 && attempts < maxAttempts) {
+    // Pick a random floor tile
+    int randomIndex = 1 + (rand() % (floors.size() - 1));
+    const auto &floor = floors[randomIndex];
+
+    // Count nearby floor tiles to ensure there's room to move
+    int openSpaces = 0;
+    for (const auto &checkFloor : floors) {
+      int dx = abs(checkFloor.x - floor.x);
+      int dy = abs(checkFloor.y - floor.y);
+      if (dx <= 2 && dy <= 2) { // Check in a 5x5 area
+        openSpaces++;
+      }
+    }
+
+    // Only spawn if there are enough open spaces
+    if (openSpaces >= 8) {
+      createMob(floor.x, floor.y, mobsCreated + 1,
+                SimulationClock::ticksFor(300));
+      mobsCreated++;
+      std::cout << "Created mob " << mobsCreated << " at (" << floor.x << ", "
+                << floor.y << ") with " << openSpaces << " open spaces nearby"
+                << std::endl;
+    }
+    attempts++;
+  }
+
+  if (mobsCreated < 5) {
+    std::cout << "Warning: Only able to create " << mobsCreated
+              << " mobs with sufficient space" << std::endl;
+  }
+  return true;
+}
+
+bool Simulation::buildTmxScenario() {
+  if (!mapLoader) {
+    std::cerr << "No map loader set for a TMX scenario!" << std::endl;
+    return false;
+  }
+
+  // For TMX maps, reload the map to ensure entities are properly created
+  std::cout << "Reloading TMX map..." << std::endl;
+  if (!mapLoader->loadMap(Constants::Assets::MAP_TMX, registry)) {
+    std::cerr << "Failed to reload TMX map!" << std::endl;
+    return false;
+  }
+  std::cout << "TMX map reloaded successfully" << std::endl;
+
+  // For TMX maps, find suitable positions for the player and mobs
+  auto floorView =
+      registry.view<Components::PositionComponent, Components::FloorTag>();
+
+  auto it = floorView.begin();
+  if (it == floorView.end()) {
+    std::cerr << "No floor tiles found in TMX map!" << std::endl;
+    return false;
+  }
+
+  // Create player at the first floor tile position
+  const auto &pos = floorView.get<Components::PositionComponent>(*it);
+  std::cout << "Creating player at (" << pos.x << ", " << pos.y << ")"
+            << std::endl;
+  entityFactory.createPlayer(pos.x, pos.y,
+                             Constants::Sprites::Tilesets::MAIN_TILESET);
+
+  // Create mobs at the following floor tiles
+  int mobCount = 0;
+  ++it; // Move to next floor tile
+  while (it != floorView.end() && mobCount < 30) {
+    const auto &mobPos = floorView.get<Components::PositionComponent>(*it);
+    std::cout << "Creating mob " << (mobCount + 1) << " at (" << mobPos.x
+              << ", " << mobPos.y << ")" << std::endl;
+    createMob(mobPos.x, mobPos.y, mobCount + 1,
+              SimulationClock::ticksFor(500));
+    ++it;
+    ++mobCount;
+  }
+  return true;
+}
+
+void Simulation::createMob(int x, int y, int number,
+                           Uint32 moveCooldownTicks) {
+  auto mobEntity = registry.create();
+  registry.emplace<Components::PositionComponent>(mobEntity, x, y);
+  registry.emplace<Components::CollisionComponent>(mobEntity, true);
+  registry.emplace<Components::SpriteComponent>(
+      mobEntity, Constants::Sprites::Tilesets::MAIN_TILESET,
+      Constants::Sprites::IDs::MOB);
+  registry.emplace<Components::MobTag>(mobEntity);
+  registry.emplace<Components::AiLodNearTag>(mobEntity);
+  registry.emplace<Components::FieldOfViewComponent>(mobEntity, PURSUIT_RANGE);
+  registry.emplace<Components::Name>(mobEntity,
+                                     "Enemy Mob " + std::to_string(number));
+
+  // Cooldowns count ticks, not wall-clock milliseconds, so fast-forwarded,
+  // headless and replayed runs behave the same
+  auto &wander = registry.emplace<Components::WanderComponent>(mobEntity);
+  wander.moveCooldown = moveCooldownTicks;
+  wander.lastMoveTick = currentTick;
+  wander.direction = -1;
+  wander.rngState = Systems::WanderSystem::seedFor(scenario.seed, number);
+}
+
+void Simulation::tick(std::span<const Input::Command> commands) {
+  Uint32 timeMs = (currentTick + 1) * SimulationClock::MS_PER_TICK;
+  tick(Replay::TickRecord{static_cast<std::uint32_t>(seedSource()), timeMs},
+       commands);
+}
+
+void Simulation::tick(const Replay::TickRecord &record,
+                      std::span<const Input::Command> commands) {
+  currentTick++;
+  gameTime = record.timeMs;
+
+  if (journalWriter) {
+    journalWriter->write(currentTick, Replay::RecordKind::TickBegin, record);
+    for (const auto &command : commands) {
+      journalWriter->write(currentTick, Replay::RecordKind::InputCommand,
+                           command);
+    }
+  }
+
+  // Everything random this tick derives from the tick seed
+  std::srand(record.seed);
+
+  tickCommands = commands;
+  systems.run(registry);
+  tickCommands = {};
+
+  dispatcher.update();
+
+  // Sync point: deliver the events queued by input and systems this tick
+  eventBus.flush();
+}
+
+void Simulation::inputSystem(entt::registry &) {
+  for (const auto &command : tickCommands) {
+    applyCommand(command);
+  }
+}
+
+void Simulation::aiLodSystem(entt::registry &) {
+  Systems::AiLodSystem(registry, currentTick);
+}
+
+void Simulation::occupancySystem(BlockerView, PlayerView) {
+  // Where colliders stand once input has moved the player; mobs moving
+  // later in the tick show up in the next one
+  occupancy.refresh(registry);
+}
+
+void Simulation::flowFieldSystem(PlayerView) {
+  playerField.update(registry, navGrid);
+}
+
+void Simulation::fieldOfViewSystem(
+    Vision::FieldOfViewSystem::Viewers viewers) {
+  fieldOfView.update(viewers, opacityGrid,
+                     entt::locator<Services::JobSystem>::value_or());
+}
+
+void Simulation::pursuitSystem(entt::registry &) {
+  using Navigation::FlowField;
+  const FlowField &field = playerField.getField();
+
+  auto players = registry.view<const Components::PositionComponent,
+                               const Components::PlayerMarker>();
+  auto seesPlayer = [&](const Components::FieldOfViewComponent &sight) {
+    for (auto [player, playerPos] : players.each()) {
+      if (sight.canSee(playerPos.x, playerPos.y)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto pursue = [&](entt::entity entity, Components::PositionComponent &pos,
+                    Components::WanderComponent &wander,
+                    const Components::FieldOfViewComponent &sight) {
+    // Walking distance, so a player behind a wall doesn't draw mobs in. A
+    // mob only notices a player it can see, but keeps chasing once it has.
+    const std::uint16_t distance = field.getDistance(pos.x, pos.y);
+    const bool pursuing = registry.all_of<Components::PursuitTag>(entity);
+    if (distance > PURSUIT_RANGE || (!pursuing && !seesPlayer(sight))) {
+      registry.remove<Components::PursuitTag>(entity);
+      return;
+    }
+    if (!pursuing) {
+      registry.emplace<Components::PursuitTag>(entity);
+      wandering.report({Systems::WanderTrace::Kind::Pursuing, entity, pos.x,
+                        pos.y, -1});
+    }
+
+    if (currentTick - wander.lastMoveTick < wander.moveCooldown) {
+      return;
+    }
+    wander.lastMoveTick = currentTick;
+
+    // Stop next to the player
+    if (distance <= 1) {
+      return;
+    }
+    const std::uint8_t dir = field.getDirection(pos.x, pos.y);
+    Components::PositionComponent next{pos.x + FlowField::DX[dir],
+                                       pos.y + FlowField::DY[dir]};
+    if (!occupancy.isBlocked(next.x, next.y)) {
+      occupancy.moveOccupant(entity, pos.x, pos.y, next.x, next.y);
+      pos = next;
+    }
+  };
+
+  // Far mobs can't be in range; they are only checked when their bucket is
+  // due, which is enough to let go of a player that ran off
+  Systems::ForEachDueAi<Components::PositionComponent,
+                        Components::WanderComponent,
+                        const Components::FieldOfViewComponent,
+                        Components::MobTag>(registry, currentTick,
+                                            entt::exclude<>, pursue);
+}
+
+void Simulation::wanderSystem(WanderView, BlockerView) {
+  // The views declare its access. Each mob draws from its own random stream,
+  // so nothing else this tick affects where it goes.
+  wandering.update(registry, occupancy, currentTick,
+                   entt::locator<Services::JobSystem>::value_or());
+}
+
+void Simulation::influenceSystem(MobView, PlayerView) {
+  // Where everyone ended up this tick, for the AI of the next
+  influence.update(registry, navGrid,
+                   entt::locator<Services::JobSystem>::value_or());
+}
+
+void Simulation::schedulerSystem(entt::registry &) {
+  // Run scheduled actions and timed events due this tick within the budget.
+  // Low-priority work that doesn't fit is deferred instead of pushing the
+  // tick past its time slice and forcing the accumulator to catch up.
+  TickBudgetReport report =
+      scheduler.update(currentTick, registry, dispatcher, SCHEDULER_BUDGET);
+  auto remaining = SCHEDULER_BUDGET - report.elapsed;
+  TickBudgetReport timedReport = timedEvents.update(
+      currentTick, std::max(remaining, std::chrono::microseconds{0}));
+  report.executed += timedReport.executed;
+  report.deferred += timedReport.deferred;
+  report.elapsed += timedReport.elapsed;
+  report.budgetExhausted |= timedReport.budgetExhausted;
+  lastBudgetReport = report;
+}
+
+void Simulation::applyCommand(const Input::Command &command) {
+  switch (command.type) {
+  case Input::Command::Type::MovePlayer: {
+    auto playerView =
+        registry.view<Components::TestComponent, Components::PositionComponent,
+                      Components::PlayerMarker>();
+    for (auto entity : playerView) {
+      if (CollisionSystem::TryMove(registry, entity, command.dx, command.dy,
+                                   eventBus)) {
+        const auto &pos = registry.get<Components::PositionComponent>(entity);
+        std::cout << "Player moved to: (" << pos.x << ", " << pos.y << ")\n";
+      }
+    }
+    break;
+  }
+  case Input::Command::Type::MoveMob:
+    if (controlledMob) {
+      controlledMob->move(command.dx, command.dy, eventBus);
+    }
+    break;
+  }
+}
+
+bool Simulation::startRecording(const std::string &path) {
+  auto writer = std::make_unique<Replay::JournalWriter>();
+  if (!writer->open(path)) {
+    return false;
+  }
+  journalWriter = std::move(writer);
+  std::cout << "Recording session to " << path << std::endl;
+
+  subscribeJournal();
+
+  // Restart from a scenario the journal knows how to rebuild
+  resetScenario();
+  return true;
+}
+
+Simulation::ReplayResult Simulation::replay(Replay::JournalReader &reader) {
+  ReplayResult result;
+  if (journalWriter) {
+    std::cerr << "Cannot replay while recording" << std::endl;
+    return result;
+  }
+
+  subscribeJournal();
+  replaying = true;
+
+  std::vector<Input::Command> commands;
+  std::vector<std::byte> recordedTraffic;
+
+  Replay::Record record;
+  bool more = reader.next(record);
+  while (more) {
+    if (record.kind == Replay::RecordKind::ScenarioReset) {
+      resetScenario(record.as<Replay::ScenarioRecord>());
+      more = reader.next(record);
+      continue;
+    }
+    if (record.kind != Replay::RecordKind::TickBegin) {
+      std::cerr << "Unexpected journal record at tick " << record.tick
+                << std::endl;
+      break;
+    }
+
+    auto tickRecord = record.as<Replay::TickRecord>();
+    commands.clear();
+    recordedTraffic.clear();
+    while ((more = reader.next(record)) &&
+           record.kind == Replay::RecordKind::InputCommand) {
+      commands.push_back(record.as<Input::Command>());
+    }
+    while (more && record.kind == Replay::RecordKind::Event) {
+      appendTraffic(recordedTraffic, record.tag, record.payload);
+      more = reader.next(record);
+    }
+
+    replayTraffic.clear();
+    tick(tickRecord, commands);
+    result.ticks++;
+
+    // The same seeds and input must reproduce the same event traffic
+    if (replayTraffic != recordedTraffic && result.divergedTicks++ == 0) {
+      result.firstDivergence = currentTick;
+    }
+  }
+
+  replaying = false;
+  return result;
+}
+
+void Simulation::subscribeJournal() {
+  if (journalSubscribed) {
+    return;
+  }
+  journalSubscribed = true;
+  eventBus.subscribeBatch<PlayerMovedEvent,
+                          &Simulation::journalEvents<PlayerMovedEvent>>(*this);
+  eventBus.subscribeBatch<MobMovedEvent,
+                          &Simulation::journalEvents<MobMovedEvent>>(*this);
+}
+
+template <typename Event>
+void Simulation::journalEvents(std::span<const Event> events) {
+  const auto tag = static_cast<std::uint8_t>(Event::type);
+  for (const auto &event : events) {
+    if (journalWriter) {
+      journalWriter->write(currentTick, Replay::RecordKind::Event, event, tag);
+    } else if (replaying) {
+      appendTraffic(replayTraffic, tag, std::as_bytes(std::span(&event, 1)));
+    }
+  }
+}
+
+} // namespace Core
@@ -0,0 +1,88 @@
+#include "core/SystemScheduler.hpp"
+#include <algorithm>
+
+namespace Core {
+
+SystemScheduler::SystemScheduler()
+    : SystemScheduler(entt::locator<Services::JobSystem>::value_or()) {}
+
+SystemScheduler::SystemScheduler(Services::JobSystem &jobs) : jobs(jobs) {}
+
+void SystemScheduler::addTiming(const char *name) {
+  timings.push_back({name ? name : "unnamed"});
+  dirty = true;
+}
+
+void SystemScheduler::clear() {
+  organizer.clear();
+  graph.clear();
+  tasks.clear();
+  timings.clear();
+  dirty = true;
+}
+
+void SystemScheduler::build() {
+  graph = organizer.graph();
+  tasks.assign(graph.size(), {});
+  for (std::size_t i = 0; i < graph.size(); ++i) {
+    tasks[i] = {&SystemScheduler::execute, this, i, i + 1, &remaining};
+  }
+  pending = std::make_unique<std::atomic<std::size_t>[]>(graph.size());
+  dirty = false;
+}
+
+void SystemScheduler::run(entt::registry &registry) {
+  if (dirty) {
+    build();
+  }
+  if (graph.empty()) {
+    return;
+  }
+
+  // Creating storages and context variables mutates the registry, so do it
+  // for every system up front rather than concurrently inside them
+  for (const auto &vertex : graph) {
+    vertex.prepare(registry);
+  }
+
+  current = &registry;
+  for (std::size_t i = 0; i < graph.size(); ++i) {
+    pending[i].store(graph[i].in_edges().size(), std::memory_order_relaxed);
+  }
+  for (std::size_t i = 0; i < graph.size(); ++i) {
+    if (graph[i].top_level()) {
+      jobs.run(tasks[i]);
+    }
+  }
+
+  jobs.wait(remaining);
+  current = nullptr;
+}
+
+void SystemScheduler::execute(void *data, std::size_t index, std::size_t) {
+  auto &self = *static_cast<SystemScheduler *>(data);
+  const auto &vertex = self.graph[index];
+
+  auto started = std::chrono::steady_clock::now();
+  vertex.callback()(vertex.data(), *self.current);
+  auto elapsed = std::chrono::steady_clock::now() - started;
+
+  // Only this thread touches this system's timing until the run completes
+  SystemTiming &timing = self.timings[index];
+  timing.last = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+  timing.slowest = std::max(timing.slowest, timing.last);
+  timing.runs++;
+  double us = std::chrono::duration<double, std::micro>(elapsed).count();
+  timing.averageUs +=
+      (us - timing.averageUs) / std::min<std::size_t>(timing.runs, 64);
+
+  // Release the systems waiting on this one. They join the run's counter
+  // before this job leaves it, so the counter can't reach zero early.
+  for (std::size_t next : vertex.out_edges()) {
+    if (self.pending[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      self.jobs.run(self.tasks[next]);
+    }
+  }
+}
+
+} // namespace Core
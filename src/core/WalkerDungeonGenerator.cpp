@@ -2,6 +2,7 @@
 #include "core/DungeonGenerator.hpp"
 #include <algorithm>
 #include <limits>
+#include <random>
 
 namespace Core {
 
@@ -9,11 +10,12 @@ WalkerDungeonGenerator::WalkerDungeonGenerator(int totalFloorCount, int minHall,
                                                int maxHall, int roomDim,
                                                int tileWidth, int tileHeight)
     : totalFloorCount(totalFloorCount), minHall(minHall), maxHall(maxHall),
-      roomDim(roomDim), tileWidth(tileWidth), tileHeight(tileHeight) {}
+      roomDim(roomDim), tileWidth(tileWidth), tileHeight(tileHeight),
+      seed(std::random_device()()) {}
 
 void WalkerDungeonGenerator::generate() {
   WalkerDungeon walker(totalFloorCount, minHall, maxHall, roomDim, tileWidth,
-                       tileHeight);
+                       tileHeight, seed);
   walker.GenerateRoomWalker();
 
   floors = walker.GetFloorList();
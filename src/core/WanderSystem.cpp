@@ -1,74 +1,120 @@
 #include "core/WanderSystem.hpp"
-#include "core/CollisionSystem.h"
-#include <cstdlib>
+#include "core/AiLodSystem.hpp"
 #include <iostream>
 
 namespace Systems {
 
-void WanderSystem(entt::registry &registry, Uint32 currentTime) {
-  auto view =
-      registry
-          .view<Components::PositionComponent, Components::WanderComponent>();
+namespace {
 
-  for (auto entity : view) {
-    auto &pos = view.get<Components::PositionComponent>(entity);
-    auto &wander = view.get<Components::WanderComponent>(entity);
+constexpr int DX[4] = {0, 1, 0, -1};
+constexpr int DY[4] = {-1, 0, 1, 0};
 
-    // Check if enough time has passed since last move
-    if (currentTime - wander.lastMoveTime < wander.moveCooldown) {
-      continue;
-    }
+} // namespace
 
-    // Pick a random direction if we don't have one
-    if (wander.direction == -1) {
-      wander.direction = rand() % 4;
-      std::cout << "Mob at (" << pos.x << "," << pos.y
-                << ") choosing new direction: " << wander.direction
-                << std::endl;
-    }
+std::uint32_t WanderSystem::seedFor(std::uint32_t seed, std::uint32_t stream) {
+  // splitmix32-style finaliser, so neighbouring streams look unrelated
+  std::uint32_t state = seed + stream * 0x9E3779B9u;
+  state = (state ^ (state >> 16)) * 0x85EBCA6Bu;
+  state = (state ^ (state >> 13)) * 0xC2B2AE35u;
+  state ^= state >> 16;
+  return state != 0 ? state : 1; // xorshift never leaves zero
+}
 
-    // Calculate movement based on direction
-    int dx = 0, dy = 0;
-    switch (wander.direction) {
-    case 0:
-      dy = -1;
-      break; // up
-    case 1:
-      dx = 1;
-      break; // right
-    case 2:
-      dy = 1;
-      break; // down
-    case 3:
-      dx = -1;
-      break; // left
-    }
+std::uint32_t WanderSystem::nextRandom(std::uint32_t &state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
 
-    // Calculate new position
-    Components::PositionComponent newPos{pos.x + dx, pos.y + dy};
+void WanderSystem::printTrace(const WanderTrace &trace) {
+  switch (trace.kind) {
+  case WanderTrace::Kind::Turned:
+    std::cout << "Mob at (" << trace.x << "," << trace.y
+              << ") choosing new direction: " << trace.direction << std::endl;
+    break;
+  case WanderTrace::Kind::Blocked:
+    std::cout << "Mob at (" << trace.x << "," << trace.y
+              << ") blocked by collision" << std::endl;
+    break;
+  case WanderTrace::Kind::Moved:
+    std::cout << "Mob moving from (" << trace.x << "," << trace.y << ") to ("
+              << trace.x + DX[trace.direction] << ","
+              << trace.y + DY[trace.direction] << ")" << std::endl;
+    break;
+  case WanderTrace::Kind::Pursuing:
+    std::cout << "Mob at (" << trace.x << "," << trace.y
+              << ") pursuing the player" << std::endl;
+    break;
+  }
+}
 
-    // Check for collisions using the CollisionSystem
-    bool blocked = CollisionSystem::CheckCollision(registry, newPos, entity);
-    if (blocked) {
-      wander.direction = -1; // Reset direction if blocked
-      std::cout << "Mob at (" << pos.x << "," << pos.y
-                << ") blocked by collision" << std::endl;
-    } else {
-      // Update position if not blocked
-      std::cout << "Mob moving from (" << pos.x << "," << pos.y << ") to ("
-                << newPos.x << "," << newPos.y << ")" << std::endl;
-      pos = newPos;
+void WanderSystem::update(entt::registry &registry,
+                          Core::OccupancyGrid &occupancy, Uint32 currentTick,
+                          Core::Services::JobSystem &jobs) {
+  // Mobs chasing the player are steered by pursuit instead, and mobs far
+  // from the player are only looked at when their LOD bucket is due
+  candidates.clear();
+  ForEachDueAi<Components::PositionComponent, Components::WanderComponent>(
+      registry, currentTick, entt::exclude<Components::PursuitTag>,
+      [&](entt::entity entity, Components::PositionComponent &pos,
+          Components::WanderComponent &wander) {
+        if (currentTick - wander.lastMoveTick >= wander.moveCooldown) {
+          candidates.push_back({entity, &pos, &wander});
+        }
+      });
 
+  // Pick each step against the static map; a mob only touches its own
+  // components and random stream
+  jobs.parallelFor(candidates.size(), [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      Candidate &candidate = candidates[i];
+      Components::WanderComponent &wander = *candidate.wander;
+      if (wander.direction == -1) {
+        wander.direction = static_cast<int>(nextRandom(wander.rngState) % 4);
+        candidate.turned = true;
+      }
       // Occasionally change direction even when not blocked
-      if (rand() % 4 == 0) {
+      candidate.turnAfter = nextRandom(wander.rngState) % 4 == 0;
+
+      candidate.toX = candidate.pos->x + DX[wander.direction];
+      candidate.toY = candidate.pos->y + DY[wander.direction];
+      candidate.wallAhead =
+          occupancy.isBlocked(candidate.toX, candidate.toY, false);
+    }
+  });
+
+  // Apply the steps in order, each seeing the ones before it
+  for (const Candidate &candidate : candidates) {
+    Components::PositionComponent &pos = *candidate.pos;
+    Components::WanderComponent &wander = *candidate.wander;
+    if (trace && candidate.turned) {
+      trace({WanderTrace::Kind::Turned, candidate.entity, pos.x, pos.y,
+             wander.direction});
+    }
+
+    const int toX = candidate.toX;
+    const int toY = candidate.toY;
+    if (candidate.wallAhead || occupancy.isBlocked(toX, toY)) {
+      if (trace) {
+        trace({WanderTrace::Kind::Blocked, candidate.entity, pos.x, pos.y,
+               wander.direction});
+      }
+      wander.direction = -1;
+    } else {
+      if (trace) {
+        trace({WanderTrace::Kind::Moved, candidate.entity, pos.x, pos.y,
+               wander.direction});
+      }
+      occupancy.moveOccupant(candidate.entity, pos.x, pos.y, toX, toY);
+      pos.x = toX;
+      pos.y = toY;
+      if (candidate.turnAfter) {
         wander.direction = -1;
-        std::cout << "Mob randomly changing direction" << std::endl;
       }
     }
-
-    // Update last move time
-    wander.lastMoveTime = currentTime;
+    wander.lastMoveTick = currentTick;
   }
 }
 
-} // namespace Systems
\ No newline at end of file
+} // namespace Systems
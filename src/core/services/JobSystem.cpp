@@ -0,0 +1,239 @@
+#include "core/services/JobSystem.hpp"
+
+namespace Core {
+namespace Services {
+
+namespace {
+
+// The pool and deque of the worker running on this thread, if any
+thread_local const JobSystem *workerSystem = nullptr;
+thread_local std::size_t workerIndex = 0;
+
+} // namespace
+
+JobSystem::WorkQueue::WorkQueue()
+    : slots(std::make_unique<std::atomic<Job *>[]>(CAPACITY)) {}
+
+bool JobSystem::WorkQueue::push(Job *job) {
+  std::int64_t b = bottom.load(std::memory_order_relaxed);
+  std::int64_t t = top.load(std::memory_order_acquire);
+  if (b - t >= CAPACITY) {
+    return false;
+  }
+  slots[b & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+  // Publishes the slot and the job it points to to stealers
+  bottom.store(b + 1, std::memory_order_release);
+  return true;
+}
+
+Job *JobSystem::WorkQueue::pop() {
+  std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+  bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::int64_t t = top.load(std::memory_order_relaxed);
+
+  if (t > b) {
+    // Empty
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  Job *job = slots[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+  if (t == b) {
+    // Last job: race stealers for it
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+      job = nullptr;
+    }
+    bottom.store(b + 1, std::memory_order_relaxed);
+  }
+  return job;
+}
+
+Job *JobSystem::WorkQueue::steal() {
+  std::int64_t t = top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::int64_t b = bottom.load(std::memory_order_acquire);
+  if (t >= b) {
+    return nullptr;
+  }
+  Job *job = slots[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+  if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                   std::memory_order_relaxed)) {
+    return nullptr; // Lost to the owner or another thief
+  }
+  return job;
+}
+
+unsigned JobSystem::defaultWorkerCount() {
+  unsigned cores = std::thread::hardware_concurrency();
+  return cores > 1 ? cores - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned workerCount) {
+  for (unsigned i = 0; i < workerCount; ++i) {
+    queues.push_back(std::make_unique<WorkQueue>());
+  }
+  workers.reserve(workerCount);
+  for (unsigned i = 0; i < workerCount; ++i) {
+    workers.emplace_back(&JobSystem::workerLoop, this, i);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopping.store(true);
+  }
+  wake.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+void JobSystem::run(std::span<Job> jobs) {
+  // Count every job before queueing any, so an early finisher can't take a
+  // shared counter to zero while the rest are still being queued
+  for (Job &job : jobs) {
+    if (job.counter) {
+      job.counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  for (Job &job : jobs) {
+    push(&job);
+  }
+}
+
+void JobSystem::runAfter(JobCounter &dependency, std::span<Job> jobs) {
+  for (Job &job : jobs) {
+    if (job.counter) {
+      job.counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(dependency.waitersMutex);
+    if (!dependency.isDone()) {
+      for (Job &job : jobs) {
+        dependency.waiters.push_back(&job);
+      }
+      return;
+    }
+  }
+  for (Job &job : jobs) {
+    push(&job);
+  }
+}
+
+void JobSystem::wait(const JobCounter &counter) {
+  while (!counter.isDone()) {
+    if (Job *job = take()) {
+      execute(job);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  // The thread that finished the last job may still hold the lock; once it
+  // lets go it no longer touches the counter, so the caller may destroy it
+  std::lock_guard<std::mutex> lock(counter.waitersMutex);
+}
+
+std::size_t JobSystem::defaultGrain(std::size_t count) const {
+  // A few chunks per thread, counting the one that waits
+  std::size_t chunks = (workers.size() + 1) * 4;
+  return std::max(MIN_GRAIN, (count + chunks - 1) / chunks);
+}
+
+void JobSystem::push(Job *job) {
+  bool queuedLocally =
+      workerSystem == this && queues[workerIndex]->push(job);
+  if (!queuedLocally) {
+    std::lock_guard<std::mutex> lock(inboxMutex);
+    inbox.push_back(job);
+  }
+
+  // Either a sleeping worker sees this count or this sees it sleeping
+  queued.fetch_add(1, std::memory_order_seq_cst);
+  if (sleeping.load(std::memory_order_seq_cst) > 0) {
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wake.notify_one();
+  }
+}
+
+Job *JobSystem::take() {
+  const bool isWorker = workerSystem == this;
+  const std::size_t self = isWorker ? workerIndex : 0;
+
+  Job *job = isWorker ? queues[self]->pop() : nullptr;
+  if (!job) {
+    std::lock_guard<std::mutex> lock(inboxMutex);
+    if (!inbox.empty()) {
+      job = inbox.front();
+      inbox.pop_front();
+    }
+  }
+  for (std::size_t offset = isWorker ? 1 : 0;
+       !job && offset < queues.size(); ++offset) {
+    job = queues[(self + offset) % queues.size()]->steal();
+  }
+
+  if (job) {
+    queued.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return job;
+}
+
+void JobSystem::execute(Job *job) {
+  job->function(job->data, job->begin, job->end);
+  if (job->counter) {
+    finish(*job->counter);
+  }
+}
+
+void JobSystem::finish(JobCounter &counter) {
+  // Jobs that aren't the last one finish without locking
+  std::size_t value = counter.value.load(std::memory_order_relaxed);
+  while (value > 1) {
+    if (counter.value.compare_exchange_weak(value, value - 1,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+      return;
+    }
+  }
+
+  // Release the jobs that were waiting on this counter
+  std::vector<Job *> ready;
+  {
+    std::lock_guard<std::mutex> lock(counter.waitersMutex);
+    if (counter.value.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return; // More jobs were added meanwhile
+    }
+    ready.swap(counter.waiters);
+  }
+  for (Job *job : ready) {
+    push(job);
+  }
+}
+
+void JobSystem::workerLoop(std::size_t self) {
+  workerSystem = this;
+  workerIndex = self;
+
+  while (true) {
+    if (Job *job = take()) {
+      execute(job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    sleeping.fetch_add(1, std::memory_order_seq_cst);
+    wake.wait(lock, [this] {
+      return stopping.load() || queued.load(std::memory_order_seq_cst) > 0;
+    });
+    sleeping.fetch_sub(1, std::memory_order_relaxed);
+    if (stopping.load()) {
+      return;
+    }
+  }
+}
+
+} // namespace Services
+} // namespace Core
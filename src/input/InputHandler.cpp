@@ -5,8 +5,8 @@
 
 namespace Input {
 
-InputHandler::InputHandler(GameManager *gameManager, EventBus &eventBus)
-    : m_gameManager(gameManager), m_eventBus(eventBus) {}
+InputHandler::InputHandler(GameManager *gameManager)
+    : m_gameManager(gameManager) {}
 
 bool InputHandler::handleInput(SDL_Event &e, entt::registry &registry,
                                Mob *mob) {
@@ -62,7 +62,9 @@ bool InputHandler::handleKeyboardInput(SDL_Event &e, entt::registry &registry,
     }
 
     if (dx != 0 || dy != 0) {
-      handlePlayerMovement(registry, dx, dy);
+      m_pendingCommands.push_back(
+          {Command::Type::MovePlayer, static_cast<std::int8_t>(dx),
+           static_cast<std::int8_t>(dy)});
       return true;
     }
   }
@@ -88,7 +90,9 @@ bool InputHandler::handleKeyboardInput(SDL_Event &e, entt::registry &registry,
     }
 
     if (dx != 0 || dy != 0) {
-      handleMobMovement(mob, dx, dy);
+      m_pendingCommands.push_back({Command::Type::MoveMob,
+                                   static_cast<std::int8_t>(dx),
+                                   static_cast<std::int8_t>(dy)});
       return true;
     }
   }
@@ -107,23 +111,4 @@ bool InputHandler::handleMouseInput(SDL_Event &e) {
   return false;
 }
 
-void InputHandler::handlePlayerMovement(entt::registry &registry, int dx,
-                                        int dy) {
-  auto playerView =
-      registry.view<Components::TestComponent, Components::PositionComponent,
-                    Components::PlayerMarker>();
-  for (auto entity : playerView) {
-    if (CollisionSystem::TryMove(registry, entity, dx, dy, m_eventBus)) {
-      const auto &pos = registry.get<Components::PositionComponent>(entity);
-      std::cout << "Player moved to: (" << pos.x << ", " << pos.y << ")\n";
-    }
-  }
-}
-
-void InputHandler::handleMobMovement(Mob *mob, int dx, int dy) {
-  if (mob) {
-    mob->move(dx, dy, m_eventBus);
-  }
-}
-
 } // namespace Input
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "navigation/FlowField.hpp"
+#include <algorithm>
+
+namespace Navigation {
+
+void FlowField::compute(const NavGrid &navGrid, std::span<const Cell> goals) {
+  grid = &navGrid;
+  distance.assign(grid->getCellCount(), UNREACHABLE);
+  direction.assign(grid->getCellCount(), NO_STEP);
+  bucket.clear();
+
+  for (const Cell &goal : goals) {
+    if (grid->isWalkable(goal.x, goal.y)) {
+      int index = grid->toIndex(goal.x, goal.y);
+      if (distance[index] != 0) {
+        distance[index] = 0;
+        bucket.push_back(index);
+      }
+    }
+  }
+
+  // Every cell in a bucket is the same distance from the goals, so a cell is
+  // final the first time it is reached. Each neighbour found points its step
+  // back at the cell it was reached from.
+  for (std::uint16_t steps = 1; !bucket.empty() && steps < UNREACHABLE;
+       ++steps) {
+    nextBucket.clear();
+    for (int index : bucket) {
+      const int x = grid->indexX(index);
+      const int y = grid->indexY(index);
+      for (int dir = 0; dir < 4; ++dir) {
+        const int nx = x + DX[dir];
+        const int ny = y + DY[dir];
+        if (!grid->contains(nx, ny)) {
+          continue;
+        }
+        const int next = grid->toIndex(nx, ny);
+        if (distance[next] != UNREACHABLE || !grid->isWalkable(next)) {
+          continue;
+        }
+        distance[next] = steps;
+        direction[next] = static_cast<std::uint8_t>((dir + 2) % 4);
+        nextBucket.push_back(next);
+      }
+    }
+    std::swap(bucket, nextBucket);
+  }
+}
+
+} // namespace Navigation
@@ -0,0 +1,32 @@
+#include "navigation/FlowFieldSystem.hpp"
+#include "core/Components.h"
+#include <algorithm>
+
+namespace Navigation {
+
+bool FlowFieldSystem::update(const entt::registry &registry,
+                             const NavGrid &grid) {
+  currentGoals.clear();
+  auto players =
+      registry.view<Components::PositionComponent, Components::PlayerMarker>();
+  for (auto [entity, pos] : players.each()) {
+    currentGoals.push_back({pos.x, pos.y});
+  }
+
+  bool goalsMoved = !std::equal(
+      goals.begin(), goals.end(), currentGoals.begin(), currentGoals.end(),
+      [](const auto &a, const auto &b) { return a.x == b.x && a.y == b.y; });
+  if (!goalsMoved && fieldGrid == &grid &&
+      gridVersion == grid.getVersion()) {
+    return false;
+  }
+
+  std::swap(goals, currentGoals);
+  fieldGrid = &grid;
+  gridVersion = grid.getVersion();
+  field.compute(grid, goals);
+  recomputes++;
+  return true;
+}
+
+} // namespace Navigation
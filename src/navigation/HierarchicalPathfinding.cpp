@@ -0,0 +1,443 @@
+#include "navigation/HierarchicalPathfinding.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Navigation {
+
+namespace {
+
+// Border openings narrower than this get one entrance in their middle;
+// wider ones get one at each end so routes needn't detour to the middle
+constexpr int WIDE_OPENING = 6;
+
+constexpr int DX[4] = {0, 1, 0, -1};
+constexpr int DY[4] = {-1, 0, 1, 0};
+
+} // namespace
+
+int HierarchicalPathfinding::clusterOf(int x, int y) const {
+  return (y - grid.getOriginY()) / CLUSTER_SIZE * clustersX +
+         (x - grid.getOriginX()) / CLUSTER_SIZE;
+}
+
+void HierarchicalPathfinding::update() {
+  if (gridVersion == grid.getVersion()) {
+    return;
+  }
+  gridVersion = grid.getVersion();
+  const auto &edits = grid.getEdits();
+
+  if (buildVersion != grid.getBuildVersion()) {
+    // A new extent: the clusters themselves move
+    buildVersion = grid.getBuildVersion();
+    rebuildAll();
+    editsSeen = edits.size();
+    return;
+  }
+
+  // Otherwise only cells changed: rebuild the clusters holding them
+  std::vector<int> dirty;
+  for (std::size_t i = editsSeen; i < edits.size(); ++i) {
+    dirty.push_back(clusterOf(grid.indexX(edits[i]), grid.indexY(edits[i])));
+  }
+  editsSeen = edits.size();
+  std::sort(dirty.begin(), dirty.end());
+  dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+  if (!dirty.empty()) {
+    rebuildClusters(dirty);
+  }
+}
+
+void HierarchicalPathfinding::rebuildAll() {
+  clustersX = (grid.getWidth() + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+  clustersY = (grid.getHeight() + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+  clusters.assign(static_cast<std::size_t>(clustersX) * clustersY, {});
+  const int right = grid.getOriginX() + grid.getWidth();
+  const int bottom = grid.getOriginY() + grid.getHeight();
+  for (int cy = 0; cy < clustersY; ++cy) {
+    for (int cx = 0; cx < clustersX; ++cx) {
+      Cluster &cluster = clusters[cy * clustersX + cx];
+      cluster.x0 = grid.getOriginX() + cx * CLUSTER_SIZE;
+      cluster.y0 = grid.getOriginY() + cy * CLUSTER_SIZE;
+      cluster.x1 = std::min(cluster.x0 + CLUSTER_SIZE, right) - 1;
+      cluster.y1 = std::min(cluster.y0 + CLUSTER_SIZE, bottom) - 1;
+    }
+  }
+
+  nodes.clear();
+  freeNodes.clear();
+  borderNodes.assign(clusters.size() * 2, {});
+  for (int border = 0; border < static_cast<int>(borderNodes.size());
+       ++border) {
+    buildBorder(border);
+  }
+  for (int c = 0; c < static_cast<int>(clusters.size()); ++c) {
+    linkCluster(c);
+  }
+  lastRebuilt = clusters.size();
+}
+
+void HierarchicalPathfinding::rebuildClusters(const std::vector<int> &dirty) {
+  // A cluster's entrances sit on its four borders, two of which are stored
+  // with its west and north neighbours
+  std::vector<int> borders;
+  for (int c : dirty) {
+    borders.push_back(c * 2);
+    borders.push_back(c * 2 + 1);
+    if (c % clustersX > 0) {
+      borders.push_back((c - 1) * 2);
+    }
+    if (c / clustersX > 0) {
+      borders.push_back((c - clustersX) * 2 + 1);
+    }
+  }
+  std::sort(borders.begin(), borders.end());
+  borders.erase(std::unique(borders.begin(), borders.end()), borders.end());
+
+  for (int border : borders) {
+    clearBorder(border);
+  }
+  for (int border : borders) {
+    buildBorder(border);
+  }
+
+  // Every cluster that lost or gained a node relinks its cached distances
+  std::vector<int> touched;
+  for (int border : borders) {
+    const int c = border / 2;
+    touched.push_back(c);
+    const bool south = border % 2 == 1;
+    if (south && c / clustersX + 1 < clustersY) {
+      touched.push_back(c + clustersX);
+    } else if (!south && c % clustersX + 1 < clustersX) {
+      touched.push_back(c + 1);
+    }
+  }
+  std::sort(touched.begin(), touched.end());
+  touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+  for (int c : touched) {
+    linkCluster(c);
+  }
+  lastRebuilt = dirty.size();
+}
+
+void HierarchicalPathfinding::clearBorder(int border) {
+  for (int id : borderNodes[border]) {
+    Node &node = nodes[id];
+    auto &members = clusters[node.cluster].nodes;
+    members.erase(std::find(members.begin(), members.end(), id));
+    node.alive = false;
+    node.edges.clear();
+    freeNodes.push_back(id);
+  }
+  borderNodes[border].clear();
+}
+
+void HierarchicalPathfinding::buildBorder(int border) {
+  const int c = border / 2;
+  const bool south = border % 2 == 1;
+  const bool edge = south ? c / clustersX + 1 >= clustersY
+                          : c % clustersX + 1 >= clustersX;
+  if (edge) {
+    return; // Nothing on the other side
+  }
+  const Cluster &near = clusters[c];
+  const int far = south ? c + clustersX : c + 1;
+  const int length = south ? near.x1 - near.x0 + 1 : near.y1 - near.y0 + 1;
+
+  // The pair of cells facing each other across the border at offset i
+  auto cellsAt = [&](int i, int &ax, int &ay, int &bx, int &by) {
+    ax = south ? near.x0 + i : near.x1;
+    ay = south ? near.y1 : near.y0 + i;
+    bx = south ? ax : ax + 1;
+    by = south ? ay + 1 : ay;
+  };
+  auto addAt = [&](int i) {
+    int ax, ay, bx, by;
+    cellsAt(i, ax, ay, bx, by);
+    addEntrance(border, grid.toIndex(ax, ay), c, grid.toIndex(bx, by), far);
+  };
+
+  int runStart = -1;
+  for (int i = 0; i <= length; ++i) {
+    bool open = false;
+    if (i < length) {
+      int ax, ay, bx, by;
+      cellsAt(i, ax, ay, bx, by);
+      open = grid.isWalkable(ax, ay) && grid.isWalkable(bx, by);
+    }
+    if (open && runStart < 0) {
+      runStart = i;
+    } else if (!open && runStart >= 0) {
+      const int runEnd = i - 1;
+      if (runEnd - runStart + 1 < WIDE_OPENING) {
+        addAt((runStart + runEnd) / 2);
+      } else {
+        addAt(runStart);
+        addAt(runEnd);
+      }
+      runStart = -1;
+    }
+  }
+}
+
+void HierarchicalPathfinding::addEntrance(int border, int cellA, int clusterA,
+                                          int cellB, int clusterB) {
+  auto allocate = [&](int cell, int cluster) {
+    int id;
+    if (!freeNodes.empty()) {
+      id = freeNodes.back();
+      freeNodes.pop_back();
+    } else {
+      id = static_cast<int>(nodes.size());
+      nodes.emplace_back();
+    }
+    Node &node = nodes[id];
+    node.cell = cell;
+    node.cluster = cluster;
+    node.border = border;
+    node.alive = true;
+    node.edges.clear();
+    clusters[cluster].nodes.push_back(id);
+    borderNodes[border].push_back(id);
+    return id;
+  };
+  const int a = allocate(cellA, clusterA);
+  const int b = allocate(cellB, clusterB);
+  nodes[a].peer = b;
+  nodes[b].peer = a;
+}
+
+void HierarchicalPathfinding::linkCluster(int c) {
+  const auto &members = clusters[c].nodes;
+  for (int id : members) {
+    Node &node = nodes[id];
+    node.edges.clear();
+    distancesFrom(c, grid.indexX(node.cell), grid.indexY(node.cell));
+    for (int other : members) {
+      if (other == id) {
+        continue;
+      }
+      const int distance = distanceTo(c, nodes[other].cell);
+      if (distance >= 0) {
+        node.edges.push_back({other, distance});
+      }
+    }
+  }
+}
+
+void HierarchicalPathfinding::distancesFrom(int c, int x, int y) {
+  // Breadth-first within the cluster only
+  const Cluster &cluster = clusters[c];
+  clusterDistance.assign(CLUSTER_SIZE * CLUSTER_SIZE, -1);
+  frontier.clear();
+
+  auto local = [&](int cx, int cy) {
+    return (cy - cluster.y0) * CLUSTER_SIZE + cx - cluster.x0;
+  };
+  clusterDistance[local(x, y)] = 0;
+  frontier.push_back(grid.toIndex(x, y));
+  for (std::size_t head = 0; head < frontier.size(); ++head) {
+    const int cx = grid.indexX(frontier[head]);
+    const int cy = grid.indexY(frontier[head]);
+    const int distance = clusterDistance[local(cx, cy)];
+    for (int dir = 0; dir < 4; ++dir) {
+      const int nx = cx + DX[dir];
+      const int ny = cy + DY[dir];
+      if (nx < cluster.x0 || nx > cluster.x1 || ny < cluster.y0 ||
+          ny > cluster.y1 || !grid.isWalkable(nx, ny) ||
+          clusterDistance[local(nx, ny)] >= 0) {
+        continue;
+      }
+      clusterDistance[local(nx, ny)] = distance + 1;
+      frontier.push_back(grid.toIndex(nx, ny));
+    }
+  }
+}
+
+int HierarchicalPathfinding::distanceTo(int c, int cell) const {
+  const Cluster &cluster = clusters[c];
+  return clusterDistance[(grid.indexY(cell) - cluster.y0) * CLUSTER_SIZE +
+                         grid.indexX(cell) - cluster.x0];
+}
+
+bool HierarchicalPathfinding::findPath(int startX, int startY, int goalX,
+                                       int goalY,
+                                       Components::PathComponent &path) {
+  path.steps.clear();
+  path.next = 0;
+  path.waypoints.clear();
+  path.nextWaypoint = 0;
+  path.goalX = goalX;
+  path.goalY = goalY;
+  lastExpanded = 0;
+
+  if (!grid.isWalkable(startX, startY) || !grid.isWalkable(goalX, goalY)) {
+    return false;
+  }
+  if (startX == goalX && startY == goalY) {
+    return true;
+  }
+
+  update();
+  if (!route(startX, startY, goalX, goalY, path)) {
+    return false;
+  }
+  return refineNext(path, startX, startY);
+}
+
+bool HierarchicalPathfinding::refineNext(Components::PathComponent &path,
+                                         int x, int y) {
+  if (path.nextWaypoint >= path.waypoints.size()) {
+    return false;
+  }
+  const auto waypoint = path.waypoints[path.nextWaypoint++];
+
+  // Legs are short and mostly inside one cluster, so plain A* is cheapest.
+  // It plans the leg as its own path; keep the route's goal.
+  const int goalX = path.goalX;
+  const int goalY = path.goalY;
+  const bool found = refiner.findPath(x, y, waypoint.x, waypoint.y, path);
+  path.goalX = goalX;
+  path.goalY = goalY;
+  return found;
+}
+
+bool HierarchicalPathfinding::route(int startX, int startY, int goalX,
+                                    int goalY,
+                                    Components::PathComponent &path) {
+  const int startCluster = clusterOf(startX, startY);
+  const int goalCluster = clusterOf(goalX, goalY);
+  const int startCell = grid.toIndex(startX, startY);
+  const int goalCell = grid.toIndex(goalX, goalY);
+
+  // The start and goal join the graph for this query only, linked to the
+  // nodes of their clusters
+  const int START = static_cast<int>(nodes.size());
+  const int GOAL = START + 1;
+
+  startEdges.clear();
+  distancesFrom(startCluster, startX, startY);
+  for (int id : clusters[startCluster].nodes) {
+    const int distance = distanceTo(startCluster, nodes[id].cell);
+    if (distance >= 0) {
+      startEdges.push_back({id, distance});
+    }
+  }
+  if (startCluster == goalCluster) {
+    const int distance = distanceTo(startCluster, goalCell);
+    if (distance >= 0) {
+      startEdges.push_back({GOAL, distance});
+    }
+  }
+
+  goalEdges.clear();
+  distancesFrom(goalCluster, goalX, goalY);
+  for (int id : clusters[goalCluster].nodes) {
+    const int distance = distanceTo(goalCluster, nodes[id].cell);
+    if (distance >= 0) {
+      goalEdges.push_back({id, distance});
+    }
+  }
+
+  if (search.size() < nodes.size() + 2) {
+    search.resize(nodes.size() + 2);
+  }
+  if (++generation == 0) {
+    for (auto &entry : search) {
+      entry.generation = 0;
+    }
+    generation = 1;
+  }
+  open.clear();
+
+  auto cellOf = [&](int id) {
+    return id == START ? startCell : id == GOAL ? goalCell : nodes[id].cell;
+  };
+  auto estimate = [&](int id) {
+    const int cell = cellOf(id);
+    return std::abs(grid.indexX(cell) - goalX) +
+           std::abs(grid.indexY(cell) - goalY);
+  };
+  auto worse = [](const OpenEntry &a, const OpenEntry &b) {
+    return a.estimate != b.estimate ? a.estimate > b.estimate
+                                    : a.cost < b.cost;
+  };
+  auto relax = [&](int from, int to, int cost) {
+    SearchNode &entry = search[to];
+    if (entry.generation != generation) {
+      entry = {generation, false, cost, from};
+    } else if (entry.closed || cost >= entry.cost) {
+      return;
+    } else {
+      entry.cost = cost;
+      entry.parent = from;
+    }
+    open.push_back({cost + estimate(to), cost, to});
+    std::push_heap(open.begin(), open.end(), worse);
+  };
+
+  search[START] = {generation, false, 0, -1};
+  open.push_back({estimate(START), 0, START});
+
+  bool found = false;
+  while (!open.empty()) {
+    std::pop_heap(open.begin(), open.end(), worse);
+    const OpenEntry current = open.back();
+    open.pop_back();
+
+    SearchNode &entry = search[current.node];
+    if (entry.closed || current.cost != entry.cost) {
+      continue;
+    }
+    entry.closed = true;
+    lastExpanded++;
+
+    if (current.node == GOAL) {
+      found = true;
+      break;
+    }
+    if (current.node == START) {
+      for (const Edge &edge : startEdges) {
+        relax(START, edge.to, edge.cost);
+      }
+      continue;
+    }
+
+    const Node &node = nodes[current.node];
+    for (const Edge &edge : node.edges) {
+      relax(current.node, edge.to, current.cost + edge.cost);
+    }
+    relax(current.node, node.peer, current.cost + 1);
+    if (node.cluster == goalCluster) {
+      for (const Edge &edge : goalEdges) {
+        if (edge.to == current.node) {
+          relax(current.node, GOAL, current.cost + edge.cost);
+          break;
+        }
+      }
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  // Keep the cells where the route enters a cluster, then the goal; the
+  // legs between them are refined later
+  routeNodes.clear();
+  for (int id = GOAL; id != START; id = search[id].parent) {
+    routeNodes.push_back(id);
+  }
+  for (auto it = routeNodes.rbegin(); it != routeNodes.rend(); ++it) {
+    const int id = *it;
+    if (id != GOAL && search[id].parent != nodes[id].peer) {
+      continue;
+    }
+    const int cell = cellOf(id);
+    path.waypoints.push_back({static_cast<std::int16_t>(grid.indexX(cell)),
+                              static_cast<std::int16_t>(grid.indexY(cell))});
+  }
+  return true;
+}
+
+} // namespace Navigation
@@ -0,0 +1,114 @@
+#include "navigation/InfluenceMap.hpp"
+#include "core/Components.h"
+
+namespace Navigation {
+
+void InfluenceMap::update(const entt::registry &registry, const NavGrid &grid,
+                          Core::Services::JobSystem &jobs) {
+  if (mapGrid != &grid || gridBuild != grid.getBuildVersion()) {
+    resize(grid);
+  }
+  if (width == 0) {
+    return;
+  }
+
+  // Straight loops over whole layers, so the compiler vectorizes them
+  for (auto &values : layers) {
+    for (float &value : values) {
+      value *= DECAY;
+    }
+  }
+
+  auto mobs = registry.view<const Components::PositionComponent,
+                            const Components::MobTag>();
+  for (auto [entity, pos] : mobs.each()) {
+    splat(Crowd, pos.x, pos.y);
+  }
+  auto players = registry.view<const Components::PositionComponent,
+                               const Components::PlayerMarker>();
+  for (auto [entity, pos] : players.each()) {
+    splat(Player, pos.x, pos.y);
+  }
+
+  for (auto &values : layers) {
+    blur(values, jobs);
+  }
+}
+
+void InfluenceMap::clear() {
+  originX = originY = width = height = 0;
+  for (auto &values : layers) {
+    values.clear();
+  }
+  scratch.clear();
+  mapGrid = nullptr;
+  gridBuild = 0;
+}
+
+void InfluenceMap::resize(const NavGrid &grid) {
+  // A new extent invalidates every cell; influence builds up again from the
+  // next updates
+  originX = grid.getOriginX();
+  originY = grid.getOriginY();
+  width = (grid.getWidth() + CELL_SIZE - 1) / CELL_SIZE;
+  height = (grid.getHeight() + CELL_SIZE - 1) / CELL_SIZE;
+  for (auto &values : layers) {
+    values.assign(static_cast<std::size_t>(width) * height, 0.0f);
+  }
+  scratch.assign(static_cast<std::size_t>(width) * height, 0.0f);
+  mapGrid = &grid;
+  gridBuild = grid.getBuildVersion();
+}
+
+void InfluenceMap::splat(Layer layer, int x, int y) {
+  if (x < originX || y < originY) {
+    return;
+  }
+  const int cellX = (x - originX) / CELL_SIZE;
+  const int cellY = (y - originY) / CELL_SIZE;
+  if (cellX < width && cellY < height) {
+    layers[layer][cellY * width + cellX] += 1.0f;
+  }
+}
+
+void InfluenceMap::blur(std::vector<float> &values,
+                        Core::Services::JobSystem &jobs) {
+  // Each pass reads one buffer and writes whole rows of the other, so rows
+  // are split across workers. Edge cells count their missing neighbour as
+  // themselves, so nothing spreads off the map.
+  const int w = width;
+  const std::size_t rows = height;
+  const std::size_t lastRow = rows - 1;
+  float *in = values.data();
+  float *out = scratch.data();
+
+  jobs.parallelFor(rows, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t y = begin; y < end; ++y) {
+      const float *src = in + y * w;
+      float *dst = out + y * w;
+      if (w == 1) {
+        dst[0] = src[0];
+        continue;
+      }
+      dst[0] = 0.75f * src[0] + 0.25f * src[1];
+      for (int x = 1; x < w - 1; ++x) {
+        dst[x] = 0.25f * src[x - 1] + 0.5f * src[x] + 0.25f * src[x + 1];
+      }
+      dst[w - 1] = 0.25f * src[w - 2] + 0.75f * src[w - 1];
+    }
+  });
+
+  jobs.parallelFor(rows, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t y = begin; y < end; ++y) {
+      const float *above = out + (y > 0 ? y - 1 : y) * w;
+      const float *row = out + y * w;
+      const float *below = out + (y < lastRow ? y + 1 : y) * w;
+      float *dst = in + y * w;
+      for (int x = 0; x < w; ++x) {
+        dst[x] = 0.25f * above[x] + 0.5f * row[x] + 0.25f * below[x];
+      }
+    }
+  });
+}
+
+} // namespace Navigation
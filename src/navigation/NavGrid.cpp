@@ -0,0 +1,88 @@
+#include "navigation/NavGrid.hpp"
+#include "core/Components.h"
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+namespace Navigation {
+
+void NavGrid::build(const entt::registry &registry) {
+  auto floors =
+      registry.view<Components::PositionComponent, Components::FloorTag>();
+  auto colliders = registry.view<Components::PositionComponent,
+                                 Components::CollisionComponent,
+                                 Components::TileColliderTag>();
+
+  int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+  for (auto [entity, pos] : floors.each()) {
+    minX = std::min(minX, pos.x);
+    minY = std::min(minY, pos.y);
+    maxX = std::max(maxX, pos.x);
+    maxY = std::max(maxY, pos.y);
+  }
+
+  if (minX > maxX) {
+    clear();
+    return;
+  }
+
+  // Walls only matter where they cover a floor, so the floors' bounds do
+  const int newWidth = maxX - minX + 1;
+  const int newHeight = maxY - minY + 1;
+  std::vector<std::uint8_t> cells(static_cast<std::size_t>(newWidth) *
+                                  newHeight);
+  auto local = [&](int x, int y) { return (y - minY) * newWidth + x - minX; };
+  for (auto [entity, pos] : floors.each()) {
+    cells[local(pos.x, pos.y)] = 1;
+  }
+  for (auto [entity, pos, collision] : colliders.each()) {
+    if (collision.isBlocking && pos.x >= minX && pos.y >= minY &&
+        pos.x <= maxX && pos.y <= maxY) {
+      cells[local(pos.x, pos.y)] = 0;
+    }
+  }
+
+  // Same extent, e.g. a hot reload: log the cells that changed as edits so
+  // users only catch up on those, and nothing at all if none did
+  if (!walkable.empty() && minX == originX && minY == originY &&
+      newWidth == width && newHeight == height) {
+    const std::size_t firstEdit = edits.size();
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+      if (cells[i] != walkable[i]) {
+        walkable[i] = cells[i];
+        edits.push_back(static_cast<int>(i));
+      }
+    }
+    if (edits.size() != firstEdit) {
+      version++;
+    }
+    return;
+  }
+
+  originX = minX;
+  originY = minY;
+  width = newWidth;
+  height = newHeight;
+  walkable = std::move(cells);
+  edits.clear();
+  version++;
+  buildVersion++;
+}
+
+void NavGrid::setWalkable(int x, int y, bool value) {
+  if (contains(x, y) && walkable[toIndex(x, y)] != value) {
+    walkable[toIndex(x, y)] = value;
+    edits.push_back(toIndex(x, y));
+    version++;
+  }
+}
+
+void NavGrid::clear() {
+  originX = originY = width = height = 0;
+  walkable.clear();
+  edits.clear();
+  version++;
+  buildVersion++;
+}
+
+} // namespace Navigation
@@ -0,0 +1,153 @@
+#include "navigation/PathCache.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace Navigation {
+
+namespace {
+
+int regionOf(const NavGrid &grid, int x, int y) {
+  const int regionsX =
+      (grid.getWidth() + PathCache::REGION_SIZE - 1) / PathCache::REGION_SIZE;
+  return (y - grid.getOriginY()) / PathCache::REGION_SIZE * regionsX +
+         (x - grid.getOriginX()) / PathCache::REGION_SIZE;
+}
+
+} // namespace
+
+bool PathCache::inRegion(int region, int x, int y) const {
+  return grid.contains(x, y) && regionOf(grid, x, y) == region;
+}
+
+bool PathCache::findPath(int startX, int startY, int goalX, int goalY,
+                         Components::PathComponent &path,
+                         Pathfinding::Solver solver) {
+  if (!grid.isWalkable(startX, startY) || !grid.isWalkable(goalX, goalY)) {
+    return pathfinding.findPath(startX, startY, goalX, goalY, path, solver);
+  }
+  sync();
+
+  const int region = regionOf(grid, startX, startY);
+  const std::uint64_t key =
+      static_cast<std::uint64_t>(region) * grid.getCellCount() +
+      grid.toIndex(goalX, goalY);
+
+  auto found = lookup.find(key);
+  if (found != lookup.end()) {
+    const Entry &entry = *found->second;
+    if (startX == entry.startX && startY == entry.startY) {
+      path.steps.assign(entry.steps.begin(), entry.steps.end());
+      path.next = 0;
+      path.goalX = goalX;
+      path.goalY = goalY;
+      entries.splice(entries.begin(), entries, found->second);
+      hits++;
+      return true;
+    }
+
+    // The route's last cell still in the region; 0 is its start
+    std::size_t exit = entry.steps.size();
+    while (exit > 0 && !inRegion(region, entry.steps[exit - 1].x,
+                                 entry.steps[exit - 1].y)) {
+      --exit;
+    }
+    const int exitX = exit > 0 ? entry.steps[exit - 1].x : entry.startX;
+    const int exitY = exit > 0 ? entry.steps[exit - 1].y : entry.startY;
+
+    // A region can hold cells that don't connect inside the map; then the
+    // entry is no use from here
+    if (pathfinding.findPath(startX, startY, exitX, exitY, path)) {
+      path.steps.insert(path.steps.end(), entry.steps.begin() + exit,
+                        entry.steps.end());
+      path.goalX = goalX;
+      path.goalY = goalY;
+      entries.splice(entries.begin(), entries, found->second);
+      hits++;
+      return true;
+    }
+  }
+
+  misses++;
+  if (!pathfinding.findPath(startX, startY, goalX, goalY, path, solver)) {
+    return false;
+  }
+  store(key, startX, startY, path.steps);
+  return true;
+}
+
+void PathCache::store(std::uint64_t key, int startX, int startY,
+                      const std::vector<Step> &steps) {
+  auto found = lookup.find(key);
+  if (found != lookup.end()) {
+    entries.splice(entries.begin(), entries, found->second);
+  } else if (lookup.size() >= capacity && !entries.empty()) {
+    // Reuse the least recently used entry, keeping its buffer
+    lookup.erase(entries.back().key);
+    entries.splice(entries.begin(), entries, std::prev(entries.end()));
+    lookup[key] = entries.begin();
+  } else {
+    entries.emplace_front();
+    lookup[key] = entries.begin();
+  }
+
+  Entry &entry = entries.front();
+  entry.key = key;
+  entry.startX = entry.minX = entry.maxX = startX;
+  entry.startY = entry.minY = entry.maxY = startY;
+  entry.steps.assign(steps.begin(), steps.end());
+  for (const Step &step : steps) {
+    entry.minX = std::min<int>(entry.minX, step.x);
+    entry.minY = std::min<int>(entry.minY, step.y);
+    entry.maxX = std::max<int>(entry.maxX, step.x);
+    entry.maxY = std::max<int>(entry.maxY, step.y);
+  }
+}
+
+void PathCache::sync() {
+  if (gridVersion == grid.getVersion()) {
+    return;
+  }
+  gridVersion = grid.getVersion();
+  const auto &edits = grid.getEdits();
+
+  if (buildVersion != grid.getBuildVersion()) {
+    buildVersion = grid.getBuildVersion();
+    editsSeen = edits.size();
+    clear();
+    return;
+  }
+
+  for (; editsSeen < edits.size() && !entries.empty(); ++editsSeen) {
+    const int cell = edits[editsSeen];
+    const int x = grid.indexX(cell);
+    const int y = grid.indexY(cell);
+    const bool open = grid.isWalkable(cell);
+
+    for (auto it = entries.begin(); it != entries.end();) {
+      const Entry &entry = *it;
+      bool stale = x >= entry.minX && x <= entry.maxX && y >= entry.minY &&
+                   y <= entry.maxY;
+      if (stale && !open) {
+        // Closed: only a route through the cell is broken
+        stale = x == entry.startX && y == entry.startY;
+        for (std::size_t i = 0; i < entry.steps.size() && !stale; ++i) {
+          stale = entry.steps[i].x == x && entry.steps[i].y == y;
+        }
+      }
+      if (stale) {
+        lookup.erase(entry.key);
+        it = entries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  editsSeen = edits.size();
+}
+
+void PathCache::clear() {
+  entries.clear();
+  lookup.clear();
+}
+
+} // namespace Navigation
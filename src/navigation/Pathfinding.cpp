@@ -0,0 +1,209 @@
+#include "navigation/Pathfinding.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Navigation {
+
+namespace {
+
+int distance(int x0, int y0, int x1, int y1) {
+  return std::abs(x1 - x0) + std::abs(y1 - y0);
+}
+
+int sign(int value) { return (value > 0) - (value < 0); }
+
+constexpr int DX[4] = {0, 1, 0, -1};
+constexpr int DY[4] = {-1, 0, 1, 0};
+
+} // namespace
+
+void Pathfinding::beginQuery() {
+  // A rebuilt grid may have a different size; start its arrays over
+  if (gridVersion != grid.getVersion() ||
+      nodes.size() != grid.getCellCount()) {
+    nodes.assign(grid.getCellCount(), Node{});
+    generation = 0;
+    gridVersion = grid.getVersion();
+  }
+
+  if (++generation == 0) {
+    // Wrapped: stale stamps could match again, so clear them once
+    for (auto &node : nodes) {
+      node.generation = 0;
+    }
+    generation = 1;
+  }
+  open.clear();
+  lastExpanded = 0;
+}
+
+bool Pathfinding::findPath(int startX, int startY, int goalX, int goalY,
+                           Components::PathComponent &path, Solver solver) {
+  path.steps.clear();
+  path.next = 0;
+  path.goalX = goalX;
+  path.goalY = goalY;
+
+  if (!grid.isWalkable(startX, startY) || !grid.isWalkable(goalX, goalY)) {
+    return false;
+  }
+  if (startX == goalX && startY == goalY) {
+    return true;
+  }
+
+  // Lowest estimate first; among equals prefer the cell furthest along, which
+  // heads straight for the goal instead of widening across open rooms
+  auto worse = [](const OpenEntry &a, const OpenEntry &b) {
+    return a.estimate != b.estimate ? a.estimate > b.estimate
+                                    : a.cost < b.cost;
+  };
+
+  beginQuery();
+  const int start = grid.toIndex(startX, startY);
+  const int goal = grid.toIndex(goalX, goalY);
+
+  Node &first = nodes[start];
+  first = {generation, false, 0, -1};
+  open.push_back({distance(startX, startY, goalX, goalY), 0, start});
+
+  // Offer a successor reached from current at a given cost
+  auto relax = [&](const OpenEntry &current, int next, int cost) {
+    Node &neighbour = nodes[next];
+    if (neighbour.generation != generation) {
+      neighbour = {generation, false, cost, current.index};
+    } else if (neighbour.closed || cost >= neighbour.cost) {
+      return;
+    } else {
+      neighbour.cost = cost;
+      neighbour.parent = current.index;
+    }
+    open.push_back({cost + distance(grid.indexX(next), grid.indexY(next),
+                                    goalX, goalY),
+                    cost, next});
+    std::push_heap(open.begin(), open.end(), worse);
+  };
+
+  bool found = false;
+  while (!open.empty()) {
+    std::pop_heap(open.begin(), open.end(), worse);
+    OpenEntry current = open.back();
+    open.pop_back();
+
+    Node &node = nodes[current.index];
+    // A cell can be queued more than once; only its cheapest entry counts
+    if (node.closed || current.cost != node.cost) {
+      continue;
+    }
+    node.closed = true;
+    lastExpanded++;
+
+    if (current.index == goal) {
+      found = true;
+      break;
+    }
+
+    const int x = grid.indexX(current.index);
+    const int y = grid.indexY(current.index);
+
+    if (solver == Solver::AStar) {
+      for (int dir = 0; dir < 4; ++dir) {
+        if (grid.isWalkable(x + DX[dir], y + DY[dir])) {
+          relax(current, grid.toIndex(x + DX[dir], y + DY[dir]),
+                current.cost + 1);
+        }
+      }
+      continue;
+    }
+
+    // Jump point search: only the directions a shortest path through this
+    // cell can continue in, each followed to the next cell worth expanding
+    int dirs[4][2];
+    int dirCount = 0;
+    if (node.parent < 0) {
+      for (int dir = 0; dir < 4; ++dir) {
+        dirs[dir][0] = DX[dir];
+        dirs[dir][1] = DY[dir];
+      }
+      dirCount = 4;
+    } else {
+      const int dx = sign(x - grid.indexX(node.parent));
+      const int dy = sign(y - grid.indexY(node.parent));
+      dirs[0][0] = dx;
+      dirs[0][1] = dy;
+      // Turning is only ever needed sideways to the direction of travel
+      dirs[1][0] = dy;
+      dirs[1][1] = dx;
+      dirs[2][0] = -dy;
+      dirs[2][1] = -dx;
+      dirCount = 3;
+    }
+    for (int i = 0; i < dirCount; ++i) {
+      const int dx = dirs[i][0];
+      const int dy = dirs[i][1];
+      const int jumpPoint = jump(x + dx, y + dy, dx, dy, goal);
+      if (jumpPoint >= 0) {
+        relax(current, jumpPoint,
+              current.cost + distance(x, y, grid.indexX(jumpPoint),
+                                      grid.indexY(jumpPoint)));
+      }
+    }
+  }
+
+  if (!found) {
+    return false;
+  }
+
+  // Walk back from the goal, filling the buffer from its end. Parents can be
+  // a straight run of cells away, so step through the cells in between.
+  // resize keeps the capacity of the path's previous plan.
+  path.steps.resize(nodes[goal].cost);
+  int x = goalX;
+  int y = goalY;
+  int index = goal;
+  std::size_t i = path.steps.size();
+  while (index != start) {
+    const int parent = nodes[index].parent;
+    const int px = grid.indexX(parent);
+    const int py = grid.indexY(parent);
+    while (x != px || y != py) {
+      path.steps[--i] = {static_cast<std::int16_t>(x),
+                         static_cast<std::int16_t>(y)};
+      x -= sign(x - px);
+      y -= sign(y - py);
+    }
+    index = parent;
+  }
+  return true;
+}
+
+int Pathfinding::jump(int x, int y, int dx, int dy, int goal) const {
+  // Moving horizontally, a cell is a jump point when a wall ends beside it,
+  // opening a turn that couldn't have been taken a step earlier. Moving
+  // vertically, it also is one when a horizontal scan from it finds one.
+  while (grid.isWalkable(x, y)) {
+    const int index = grid.toIndex(x, y);
+    if (index == goal) {
+      return index;
+    }
+    if (dx != 0) {
+      if ((grid.isWalkable(x, y - 1) && !grid.isWalkable(x - dx, y - 1)) ||
+          (grid.isWalkable(x, y + 1) && !grid.isWalkable(x - dx, y + 1))) {
+        return index;
+      }
+    } else {
+      if ((grid.isWalkable(x - 1, y) && !grid.isWalkable(x - 1, y - dy)) ||
+          (grid.isWalkable(x + 1, y) && !grid.isWalkable(x + 1, y - dy))) {
+        return index;
+      }
+      if (jump(x + 1, y, 1, 0, goal) >= 0 ||
+          jump(x - 1, y, -1, 0, goal) >= 0) {
+        return index;
+      }
+    }
+    x += dx;
+    y += dy;
+  }
+  return -1;
+}
+
+} // namespace Navigation
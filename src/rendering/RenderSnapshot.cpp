@@ -0,0 +1,66 @@
+#include "rendering/RenderSnapshot.hpp"
+#include "core/Components.h"
+#include <algorithm>
+
+namespace Rendering {
+
+void RenderSnapshot::capture(const entt::registry &registry, int currentTick) {
+  tick = currentTick;
+  sprites.clear();
+
+  hasFocus = false;
+  const Components::FieldOfViewComponent *sight = nullptr;
+  auto playerView = registry.view<const Components::PositionComponent,
+                                  const Components::PlayerMarker>();
+  for (auto entity : playerView) {
+    const auto &pos =
+        playerView.get<const Components::PositionComponent>(entity);
+    hasFocus = true;
+    focusX = pos.x;
+    focusY = pos.y;
+    // Until its field is first computed, draw everything
+    sight = registry.try_get<Components::FieldOfViewComponent>(entity);
+    if (!fogOfWar || (sight && sight->computedRadius < 0)) {
+      sight = nullptr;
+    }
+    break; // Only use the first player entity
+  }
+
+  // Fogged cells are culled here, so the renderer never sees them
+  auto append = [this, sight](const Components::PositionComponent &pos,
+                              const Components::SpriteComponent &sprite) {
+    if (sight && !sight->canSee(pos.x, pos.y)) {
+      return;
+    }
+    sprites.push_back(
+        {pos.x, pos.y, sprite.tileId, tilesetIndex(sprite.tilesetName)});
+  };
+
+  // Same draw order as the map: floor tiles, wall tiles, then entities
+  registry
+      .view<const Components::PositionComponent,
+            const Components::SpriteComponent, const Components::FloorTag>()
+      .each(append);
+  registry
+      .view<const Components::PositionComponent,
+            const Components::SpriteComponent,
+            const Components::TileColliderTag>()
+      .each(append);
+  registry
+      .view<const Components::PositionComponent,
+            const Components::SpriteComponent>(
+          entt::exclude<Components::FloorTag, Components::TileColliderTag>)
+      .each(append);
+}
+
+std::uint16_t RenderSnapshot::tilesetIndex(const std::string &name) {
+  // There are only ever a handful of tilesets
+  auto it = std::find(tilesets.begin(), tilesets.end(), name);
+  if (it != tilesets.end()) {
+    return static_cast<std::uint16_t>(it - tilesets.begin());
+  }
+  tilesets.push_back(name);
+  return static_cast<std::uint16_t>(tilesets.size() - 1);
+}
+
+} // namespace Rendering
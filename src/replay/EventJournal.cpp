@@ -0,0 +1,205 @@
+#include "replay/EventJournal.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Replay {
+
+namespace {
+
+constexpr std::uint32_t JOURNAL_MAGIC = 0x4a474642; // "BFGJ"
+constexpr std::uint16_t JOURNAL_VERSION = 6; // 6: per-mob random streams
+constexpr std::size_t FILE_HEADER_SIZE = 8;
+constexpr std::size_t RECORD_HEADER_SIZE = 8;
+constexpr std::size_t GROW_CHUNK = 4 * 1024 * 1024;
+
+struct RecordHeader {
+  std::uint32_t tick;
+  std::uint8_t kind;
+  std::uint8_t tag;
+  std::uint16_t size;
+};
+static_assert(sizeof(RecordHeader) == RECORD_HEADER_SIZE);
+
+} // namespace
+
+JournalWriter::~JournalWriter() { close(); }
+
+bool JournalWriter::open(const std::string &filePath) {
+  close();
+
+  fd = ::open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    std::cerr << "Failed to create journal: " << filePath << " ("
+              << std::strerror(errno) << ")" << std::endl;
+    return false;
+  }
+  path = filePath;
+
+  if (!grow(FILE_HEADER_SIZE)) {
+    close();
+    return false;
+  }
+
+  std::uint16_t reserved = 0;
+  std::memcpy(mapped, &JOURNAL_MAGIC, 4);
+  std::memcpy(mapped + 4, &JOURNAL_VERSION, 2);
+  std::memcpy(mapped + 6, &reserved, 2);
+  used = FILE_HEADER_SIZE;
+  return true;
+}
+
+void JournalWriter::close() {
+  if (mapped) {
+    ::munmap(mapped, capacity);
+    mapped = nullptr;
+  }
+  if (fd >= 0) {
+    // Drop the unused tail of the last chunk
+    if (::ftruncate(fd, static_cast<off_t>(used)) != 0) {
+      std::cerr << "Failed to truncate journal: " << path << std::endl;
+    }
+    ::close(fd);
+    fd = -1;
+  }
+  capacity = 0;
+  used = 0;
+}
+
+void JournalWriter::writeRecord(std::uint32_t tick, RecordKind kind,
+                                std::uint8_t tag, const void *data,
+                                std::size_t size) {
+  if (!isOpen()) {
+    return;
+  }
+  if (size > UINT16_MAX) {
+    std::cerr << "Journal record too large: " << size << " bytes" << std::endl;
+    return;
+  }
+  if (used + RECORD_HEADER_SIZE + size > capacity &&
+      !grow(RECORD_HEADER_SIZE + size)) {
+    close();
+    return;
+  }
+
+  RecordHeader header{tick, static_cast<std::uint8_t>(kind), tag,
+                      static_cast<std::uint16_t>(size)};
+  std::memcpy(mapped + used, &header, RECORD_HEADER_SIZE);
+  std::memcpy(mapped + used + RECORD_HEADER_SIZE, data, size);
+  used += RECORD_HEADER_SIZE + size;
+}
+
+bool JournalWriter::grow(std::size_t needed) {
+  std::size_t newCapacity = capacity + std::max(needed, GROW_CHUNK);
+
+  if (mapped) {
+    ::munmap(mapped, capacity);
+    mapped = nullptr;
+  }
+
+  if (::ftruncate(fd, static_cast<off_t>(newCapacity)) != 0) {
+    std::cerr << "Failed to grow journal: " << path << " ("
+              << std::strerror(errno) << ")" << std::endl;
+    return false;
+  }
+
+  void *memory = ::mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, fd, 0);
+  if (memory == MAP_FAILED) {
+    std::cerr << "Failed to map journal: " << path << " ("
+              << std::strerror(errno) << ")" << std::endl;
+    return false;
+  }
+
+  mapped = static_cast<std::byte *>(memory);
+  capacity = newCapacity;
+  return true;
+}
+
+JournalReader::~JournalReader() { close(); }
+
+bool JournalReader::open(const std::string &path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Failed to open journal: " << path << " ("
+              << std::strerror(errno) << ")" << std::endl;
+    return false;
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < FILE_HEADER_SIZE) {
+    std::cerr << "Journal is empty or unreadable: " << path << std::endl;
+    ::close(fd);
+    return false;
+  }
+
+  length = static_cast<std::size_t>(info.st_size);
+  void *memory = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // The mapping stays valid
+  if (memory == MAP_FAILED) {
+    std::cerr << "Failed to map journal: " << path << std::endl;
+    length = 0;
+    return false;
+  }
+  mapped = static_cast<const std::byte *>(memory);
+  ::madvise(memory, length, MADV_SEQUENTIAL);
+
+  std::uint32_t magic = 0;
+  std::uint16_t version = 0;
+  std::memcpy(&magic, mapped, 4);
+  std::memcpy(&version, mapped + 4, 2);
+  if (magic != JOURNAL_MAGIC || version != JOURNAL_VERSION) {
+    std::cerr << "Not a supported journal file: " << path << std::endl;
+    close();
+    return false;
+  }
+
+  offset = FILE_HEADER_SIZE;
+  return true;
+}
+
+void JournalReader::close() {
+  if (mapped) {
+    ::munmap(const_cast<std::byte *>(mapped), length);
+    mapped = nullptr;
+  }
+  length = 0;
+  offset = 0;
+}
+
+bool JournalReader::next(Record &record) {
+  if (!mapped || length - offset < RECORD_HEADER_SIZE) {
+    return false;
+  }
+
+  RecordHeader header;
+  std::memcpy(&header, mapped + offset, RECORD_HEADER_SIZE);
+
+  // A journal whose writer never closed still has the zeroed tail of its
+  // last chunk; no real record is all zeroes
+  if (header.kind == 0 && header.size == 0) {
+    return false;
+  }
+
+  if (length - offset - RECORD_HEADER_SIZE < header.size ||
+      header.kind > static_cast<std::uint8_t>(RecordKind::Event)) {
+    std::cerr << "Corrupt journal record at offset " << offset << std::endl;
+    return false;
+  }
+
+  record.tick = header.tick;
+  record.kind = static_cast<RecordKind>(header.kind);
+  record.tag = header.tag;
+  record.payload = {mapped + offset + RECORD_HEADER_SIZE, header.size};
+  offset += RECORD_HEADER_SIZE + header.size;
+  return true;
+}
+
+} // namespace Replay
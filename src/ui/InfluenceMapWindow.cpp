@@ -0,0 +1,86 @@
+#include "ui/InfluenceMapWindow.hpp"
+#include <algorithm>
+#include <cmath>
+#include <imgui.h>
+
+namespace UI {
+
+namespace {
+
+// Dark blue through red to yellow as the value approaches the peak
+ImU32 heatColor(float t) {
+  const float r = std::min(1.0f, t * 2.0f);
+  const float g = std::max(0.0f, t * 2.0f - 1.0f);
+  const float b = 0.4f * (1.0f - t);
+  return IM_COL32(static_cast<int>(r * 255), static_cast<int>(g * 255),
+                  static_cast<int>(b * 255), 255);
+}
+
+} // namespace
+
+InfluenceMapWindow::InfluenceMapWindow(const std::string &title, bool *show)
+    : DebugWindow(title, show) {}
+
+void InfluenceMapWindow::render(entt::registry &) {
+  if (!isVisible())
+    return;
+
+  if (ImGui::Begin(getTitle().c_str(), getShowPtr())) {
+    using Navigation::InfluenceMap;
+    if (!influence || influence->getWidth() == 0) {
+      ImGui::TextDisabled("No influence map yet");
+      ImGui::End();
+      return;
+    }
+
+    ImGui::RadioButton("Crowd", &layer, InfluenceMap::Crowd);
+    ImGui::SameLine();
+    ImGui::RadioButton("Player", &layer, InfluenceMap::Player);
+
+    const auto &values =
+        influence->getValues(static_cast<InfluenceMap::Layer>(layer));
+    const float peak = *std::max_element(values.begin(), values.end());
+    const int width = influence->getWidth();
+    const int height = influence->getHeight();
+    ImGui::Text("%d x %d cells of %d tiles, peak %.2f", width, height,
+                InfluenceMap::CELL_SIZE, peak);
+
+    // Largest whole number of pixels per cell that fits, at least one
+    const ImVec2 available = ImGui::GetContentRegionAvail();
+    const float cell = std::max(
+        1.0f, std::floor(std::min(available.x / width, available.y / height)));
+    const ImVec2 corner = ImGui::GetCursorScreenPos();
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(
+        corner, ImVec2(corner.x + width * cell, corner.y + height * cell),
+        heatColor(0.0f));
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        const float value = values[y * width + x];
+        // Faint traces would only repaint the background
+        if (peak <= 0.0f || value < peak * 0.01f) {
+          continue;
+        }
+        const ImVec2 min(corner.x + x * cell, corner.y + y * cell);
+        drawList->AddRectFilled(min, ImVec2(min.x + cell, min.y + cell),
+                                heatColor(value / peak));
+      }
+    }
+    ImGui::Dummy(ImVec2(width * cell, height * cell));
+
+    if (ImGui::IsItemHovered()) {
+      const ImVec2 mouse = ImGui::GetMousePos();
+      const int x = std::clamp(static_cast<int>((mouse.x - corner.x) / cell),
+                               0, width - 1);
+      const int y = std::clamp(static_cast<int>((mouse.y - corner.y) / cell),
+                               0, height - 1);
+      ImGui::SetTooltip("Tiles (%d,%d): %.3f",
+                        influence->getOriginX() + x * InfluenceMap::CELL_SIZE,
+                        influence->getOriginY() + y * InfluenceMap::CELL_SIZE,
+                        values[y * width + x]);
+    }
+  }
+  ImGui::End();
+}
+
+} // namespace UI
@@ -160,6 +160,20 @@ void PerformanceWindow::render(entt::registry &registry) {
       plotHistory("CPU History", cpuHistory, 0.0f, 100.0f);
     }
 
+    // Systems Section
+    if (systems && ImGui::CollapsingHeader("Systems",
+                                           ImGuiTreeNodeFlags_DefaultOpen)) {
+      ImGui::Text("Workers: %u + main thread", systems->getWorkerCount());
+      for (const auto &timing : systems->getTimings()) {
+        ImGui::Text(
+            "%-12s last %7.1f us  avg %7.1f us  max %7.1f us",
+            timing.name.c_str(),
+            std::chrono::duration<double, std::micro>(timing.last).count(),
+            timing.averageUs,
+            std::chrono::duration<double, std::micro>(timing.slowest).count());
+      }
+    }
+
     // Entity Stats Section
     if (ImGui::CollapsingHeader("Entity Stats",
                                 ImGuiTreeNodeFlags_DefaultOpen)) {
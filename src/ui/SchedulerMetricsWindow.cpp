@@ -0,0 +1,153 @@
+#include "ui/SchedulerMetricsWindow.hpp"
+#include <algorithm>
+#include <imgui.h>
+#include <vector>
+
+namespace UI {
+
+SchedulerMetricsWindow::SchedulerMetricsWindow(const std::string &title,
+                                               bool *show)
+    : DebugWindow(title, show) {}
+
+void SchedulerMetricsWindow::render(entt::registry &) {
+  if (!isVisible())
+    return;
+
+  if (ImGui::Begin(getTitle().c_str(), getShowPtr())) {
+    // The budget report is always available, even with metrics compiled out
+    ImGui::Text("Last update: %zu executed, %zu deferred in %lld us",
+                m_budgetReport.executed, m_budgetReport.deferred,
+                static_cast<long long>(m_budgetReport.elapsed.count()));
+    if (m_budgetReport.budgetExhausted) {
+      ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f),
+                         "Tick budget exhausted, work deferred");
+    }
+    ImGui::Separator();
+
+    if (!SchedulerMetrics::compiledIn()) {
+      ImGui::TextDisabled("Scheduler metrics are compiled out.");
+      ImGui::TextDisabled("Configure with -DENABLE_SCHEDULER_METRICS=ON.");
+      ImGui::End();
+      return;
+    }
+
+    for (auto *metrics : m_sources) {
+      if (metrics) {
+        renderSource(*metrics);
+      }
+    }
+
+    if (!m_lastExportMessage.empty()) {
+      ImGui::Separator();
+      ImGui::TextWrapped("%s", m_lastExportMessage.c_str());
+    }
+  }
+  ImGui::End();
+}
+
+void SchedulerMetricsWindow::renderSource(SchedulerMetrics &metrics) {
+  if (!ImGui::CollapsingHeader(metrics.getName().c_str(),
+                               ImGuiTreeNodeFlags_DefaultOpen)) {
+    return;
+  }
+
+  // Flatten the ring buffer into plot-friendly arrays
+  std::vector<float> depth, executed, lateness, busyMs;
+  depth.reserve(metrics.tickCount());
+  executed.reserve(metrics.tickCount());
+  lateness.reserve(metrics.tickCount());
+  busyMs.reserve(metrics.tickCount());
+  metrics.forEachTick([&](const SchedulerMetrics::TickSample &sample) {
+    depth.push_back(static_cast<float>(sample.activeCount));
+    executed.push_back(static_cast<float>(sample.executed));
+    lateness.push_back(static_cast<float>(sample.maxLateness));
+    busyMs.push_back(sample.busyNs / 1.0e6f);
+  });
+
+  if (metrics.tickCount() > 0) {
+    const auto &latest = metrics.latest();
+    ImGui::Text("Tick %d: %u pending (%u queued), %u executed, %u deferred",
+                latest.tick, latest.activeCount, latest.queueDepth,
+                latest.executed, latest.deferred);
+    ImGui::Text("Max lateness: %d ticks, busy: %.3f ms", latest.maxLateness,
+                latest.busyNs / 1.0e6);
+  } else {
+    ImGui::TextDisabled("No ticks recorded yet");
+  }
+
+  const int count = static_cast<int>(depth.size());
+  ImGui::PushID(&metrics);
+  ImGui::PlotLines("Queue depth", depth.data(), count, 0, nullptr, 0.0f,
+                   FLT_MAX, ImVec2(0, 40));
+  ImGui::PlotLines("Executed/tick", executed.data(), count, 0, nullptr, 0.0f,
+                   FLT_MAX, ImVec2(0, 40));
+  ImGui::PlotLines("Max lateness", lateness.data(), count, 0, nullptr, 0.0f,
+                   FLT_MAX, ImVec2(0, 40));
+  ImGui::PlotLines("Busy (ms)", busyMs.data(), count, 0, nullptr, 0.0f,
+                   FLT_MAX, ImVec2(0, 40));
+
+  renderLabelTable(metrics);
+
+  std::string basePath = "scheduler_metrics_" + metrics.getName();
+  std::replace(basePath.begin(), basePath.end(), ' ', '_');
+  if (ImGui::Button("Export CSV")) {
+    m_lastExportMessage = metrics.exportCsv(basePath)
+                              ? "Wrote " + basePath + "_ticks.csv and " +
+                                    basePath + "_actions.csv"
+                              : "Failed to write " + basePath + "_*.csv";
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Export JSON")) {
+    m_lastExportMessage = metrics.exportJson(basePath + ".json")
+                              ? "Wrote " + basePath + ".json"
+                              : "Failed to write " + basePath + ".json";
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Reset")) {
+    metrics.reset();
+  }
+  ImGui::PopID();
+}
+
+void SchedulerMetricsWindow::renderLabelTable(const SchedulerMetrics &metrics) {
+  const auto &labels = metrics.getLabelStats();
+  if (labels.empty()) {
+    return;
+  }
+
+  if (ImGui::BeginTable("labels", 5,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+    ImGui::TableSetupColumn("Label");
+    ImGui::TableSetupColumn("Count");
+    ImGui::TableSetupColumn("Avg (us)");
+    ImGui::TableSetupColumn("Max (us)");
+    ImGui::TableSetupColumn("Cost histogram");
+    ImGui::TableHeadersRow();
+
+    for (const auto &[label, stats] : labels) {
+      std::array<float, SchedulerMetrics::HISTOGRAM_BUCKETS> histogram{};
+      std::transform(stats.histogram.begin(), stats.histogram.end(),
+                     histogram.begin(),
+                     [](std::uint32_t value) { return float(value); });
+
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("%s", label.c_str());
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(stats.count));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", SchedulerMetrics::averageUs(stats));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f", stats.maxNs / 1000.0);
+      ImGui::TableNextColumn();
+      ImGui::PushID(label.c_str());
+      ImGui::PlotHistogram("##cost", histogram.data(),
+                           static_cast<int>(histogram.size()), 0, nullptr,
+                           0.0f, FLT_MAX, ImVec2(120, 20));
+      ImGui::PopID();
+    }
+    ImGui::EndTable();
+  }
+}
+
+} // namespace UI
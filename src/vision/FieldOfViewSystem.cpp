@@ -0,0 +1,159 @@
+#include "vision/FieldOfViewSystem.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <span>
+
+namespace Vision {
+
+namespace {
+
+// Slope of a line from the origin, as a fraction with a positive denominator
+struct Slope {
+  int num;
+  int den;
+};
+
+int floorDiv(int a, int b) { return a / b - (a % b != 0 && a < 0); }
+
+// The column nearest depth * slope, with ties rounding up or down
+int roundTiesUp(int depth, Slope slope) {
+  return floorDiv(2 * depth * slope.num + slope.den, 2 * slope.den);
+}
+int roundTiesDown(int depth, Slope slope) {
+  return -floorDiv(slope.den - 2 * depth * slope.num, 2 * slope.den);
+}
+
+// Casts one quadrant. Rows run away from the origin along the quadrant's
+// axis at increasing depth; columns run across it.
+struct Caster {
+  const OpacityGrid &grid;
+  Components::FieldOfViewComponent &field;
+  int originX;
+  int originY;
+  int radius;
+  int quadrant; // North, east, south, west
+
+  void toCell(int depth, int col, int &x, int &y) const {
+    switch (quadrant) {
+    case 0:
+      x = originX + col;
+      y = originY - depth;
+      break;
+    case 1:
+      x = originX + depth;
+      y = originY + col;
+      break;
+    case 2:
+      x = originX + col;
+      y = originY + depth;
+      break;
+    default:
+      x = originX - depth;
+      y = originY + col;
+      break;
+    }
+  }
+
+  bool isOpaque(int depth, int col) const {
+    int x, y;
+    toCell(depth, col, x, y);
+    return grid.isOpaque(x, y);
+  }
+
+  void reveal(int depth, int col) {
+    // Round the square of cells off to a circle
+    if (depth * depth + col * col > radius * radius + radius) {
+      return;
+    }
+    int x, y;
+    toCell(depth, col, x, y);
+    const int side = 2 * radius + 1;
+    const int bit = (y - originY + radius) * side + x - originX + radius;
+    field.bits[bit / 64] |= std::uint64_t{1} << (bit % 64);
+  }
+
+  // Scan a row between two slopes, splitting it around walls. A floor cell
+  // is only revealed when its centre lies between the slopes, which is what
+  // makes the result symmetric; walls are revealed whenever touched.
+  void scan(int depth, Slope start, Slope end) {
+    if (depth > radius) {
+      return;
+    }
+    bool hasPrevious = false;
+    bool previousOpaque = false;
+    const int last = roundTiesDown(depth, end);
+    for (int col = roundTiesUp(depth, start); col <= last; ++col) {
+      const bool opaque = isOpaque(depth, col);
+      if (opaque || (col * start.den >= depth * start.num &&
+                     col * end.den <= depth * end.num)) {
+        reveal(depth, col);
+      }
+      if (hasPrevious && previousOpaque && !opaque) {
+        start = {2 * col - 1, 2 * depth};
+      }
+      if (hasPrevious && !previousOpaque && opaque) {
+        scan(depth + 1, start, {2 * col - 1, 2 * depth});
+      }
+      hasPrevious = true;
+      previousOpaque = opaque;
+    }
+    if (hasPrevious && !previousOpaque) {
+      scan(depth + 1, start, end);
+    }
+  }
+};
+
+} // namespace
+
+void FieldOfViewSystem::compute(const OpacityGrid &grid, int x, int y,
+                                int radius,
+                                Components::FieldOfViewComponent &field) {
+  const int side = 2 * radius + 1;
+  field.bits.assign((side * side + 63) / 64, 0);
+  field.originX = x;
+  field.originY = y;
+  field.computedRadius = radius;
+
+  const int centre = radius * side + radius;
+  field.bits[centre / 64] |= std::uint64_t{1} << (centre % 64);
+  for (int quadrant = 0; quadrant < 4; ++quadrant) {
+    Caster caster{grid, field, x, y, radius, quadrant};
+    caster.scan(1, {-1, 1}, {1, 1});
+  }
+}
+
+std::size_t FieldOfViewSystem::update(const Viewers &viewers,
+                                      const OpacityGrid &grid,
+                                      Core::Services::JobSystem &jobs) {
+  // A rebuilt grid may have moved every wall; otherwise only the cells
+  // edited since the last update matter
+  const bool rebuilt = buildVersion != grid.getBuildVersion();
+  buildVersion = grid.getBuildVersion();
+  const auto &edits = grid.getEdits();
+  std::span<const OpacityGrid::Cell> changed;
+  if (!rebuilt && editsSeen < edits.size()) {
+    changed = std::span(edits).subspan(editsSeen);
+  }
+  editsSeen = edits.size();
+
+  std::atomic<std::size_t> count{0};
+  jobs.parallelFor(viewers, [&](entt::entity entity) {
+    const auto &pos = viewers.get<const Components::PositionComponent>(entity);
+    auto &field = viewers.get<Components::FieldOfViewComponent>(entity);
+    bool stale = rebuilt || field.computedRadius != field.radius ||
+                 field.originX != pos.x || field.originY != pos.y;
+    for (std::size_t i = 0; i < changed.size() && !stale; ++i) {
+      stale = std::abs(changed[i].x - field.originX) <= field.radius &&
+              std::abs(changed[i].y - field.originY) <= field.radius;
+    }
+    if (stale) {
+      compute(grid, pos.x, pos.y, field.radius, field);
+      count.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  recomputes += count.load(std::memory_order_relaxed);
+  return count.load(std::memory_order_relaxed);
+}
+
+} // namespace Vision
@@ -0,0 +1,100 @@
+#include "vision/OpacityGrid.hpp"
+#include "core/Components.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <utility>
+
+namespace Vision {
+
+void OpacityGrid::build(const entt::registry &registry) {
+  auto walls = registry.view<Components::PositionComponent,
+                             Components::CollisionComponent,
+                             Components::TileColliderTag>();
+  auto floors =
+      registry.view<Components::PositionComponent, Components::FloorTag>();
+
+  int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+  auto extend = [&](const Components::PositionComponent &pos) {
+    minX = std::min(minX, pos.x);
+    minY = std::min(minY, pos.y);
+    maxX = std::max(maxX, pos.x);
+    maxY = std::max(maxY, pos.y);
+  };
+  for (auto [entity, pos] : floors.each()) {
+    extend(pos);
+  }
+  for (auto [entity, pos, collision] : walls.each()) {
+    extend(pos);
+  }
+
+  if (minX > maxX) {
+    clear();
+    return;
+  }
+
+  const int newWidth = maxX - minX + 1;
+  const int newHeight = maxY - minY + 1;
+  const int newWordsPerRow = (newWidth + 63) / 64;
+  std::vector<std::uint64_t> bits(
+      static_cast<std::size_t>(newWordsPerRow) * newHeight, 0);
+  for (auto [entity, pos, collision] : walls.each()) {
+    if (collision.isBlocking) {
+      const int col = pos.x - minX;
+      bits[(pos.y - minY) * newWordsPerRow + col / 64] |= std::uint64_t{1}
+                                                         << (col % 64);
+    }
+  }
+
+  // Same extent, e.g. a hot reload: log the cells that changed as edits
+  if (!words.empty() && minX == originX && minY == originY &&
+      newWidth == width && newHeight == height) {
+    const std::size_t firstEdit = edits.size();
+    for (std::size_t i = 0; i < words.size(); ++i) {
+      std::uint64_t changed = words[i] ^ bits[i];
+      while (changed) {
+        const int bit = std::countr_zero(changed);
+        changed &= changed - 1;
+        const int row = static_cast<int>(i) / wordsPerRow;
+        const int word = static_cast<int>(i) % wordsPerRow;
+        edits.push_back({originX + word * 64 + bit, originY + row});
+      }
+      words[i] = bits[i];
+    }
+    if (edits.size() != firstEdit) {
+      version++;
+    }
+    return;
+  }
+
+  originX = minX;
+  originY = minY;
+  width = newWidth;
+  height = newHeight;
+  wordsPerRow = newWordsPerRow;
+  words = std::move(bits);
+  edits.clear();
+  version++;
+  buildVersion++;
+}
+
+void OpacityGrid::setOpaque(int x, int y, bool value) {
+  if (!contains(x, y) || isOpaque(x, y) == value) {
+    return;
+  }
+  const int col = x - originX;
+  words[(y - originY) * wordsPerRow + col / 64] ^= std::uint64_t{1}
+                                                   << (col % 64);
+  edits.push_back({x, y});
+  version++;
+}
+
+void OpacityGrid::clear() {
+  originX = originY = width = height = wordsPerRow = 0;
+  words.clear();
+  edits.clear();
+  version++;
+  buildVersion++;
+}
+
+} // namespace Vision
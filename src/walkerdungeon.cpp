@@ -5,10 +5,11 @@
 
 // Constructor: Initialize parameters and seed the RNG.
 WalkerDungeon::WalkerDungeon(int totalFloorCount, int minHall, int maxHall,
-                             int roomDim, int tileWidth, int tileHeight)
+                             int roomDim, int tileWidth, int tileHeight,
+                             unsigned int seed)
     : totalFloorCount(totalFloorCount), minHall(minHall), maxHall(maxHall),
       roomDim(roomDim), tileWidth(tileWidth), tileHeight(tileHeight),
-      rng(std::random_device()()) {
+      rng(seed) {
   // Adjust room dimensions based on tile size
   this->roomDim = (roomDim * 16) /
                   tileWidth; // Scale room size relative to default 16px tiles